@@ -1,5 +1,6 @@
 #include "CameraPawnCreationCommandlet.h"
 #include "CameraPawnCreationLog.h"
+#include "CharacterCreationCommandlet/SourceTemplate.h"
 #include "HAL/PlatformFilemanager.h"
 #include "Misc/Paths.h"
 #include "AssetRegistry/AssetRegistryModule.h"
@@ -68,18 +69,14 @@ bool UCameraPawnCreationCommandlet::CreateCameraPawnClass()
     FString SourceDir = ProjectDir / TEXT("Source") / TEXT("CharacterCreationCpp");
     
     // Write header file
-    FString HeaderPath = SourceDir / TEXT("CameraPawn.h");
-    FString HeaderContent = GenerateCameraPawnHeader();
-    if (!WriteSourceFile(HeaderPath, HeaderContent))
+    if (!GenerateSourceFile(TEXT("CameraPawn.h"), SourceDir / TEXT("CameraPawn.h")))
     {
         UE_LOG(LogCameraPawnCreation, Error, TEXT("Failed to write CameraPawn.h"));
         return false;
     }
     
     // Write cpp file
-    FString CppPath = SourceDir / TEXT("CameraPawn.cpp");
-    FString CppContent = GenerateCameraPawnCpp();
-    if (!WriteSourceFile(CppPath, CppContent))
+    if (!GenerateSourceFile(TEXT("CameraPawn.cpp"), SourceDir / TEXT("CameraPawn.cpp")))
     {
         UE_LOG(LogCameraPawnCreation, Error, TEXT("Failed to write CameraPawn.cpp"));
         return false;
@@ -89,202 +86,6 @@ bool UCameraPawnCreationCommandlet::CreateCameraPawnClass()
     return true;
 }
 
-FString UCameraPawnCreationCommandlet::GenerateCameraPawnHeader()
-{
-    return TEXT("#pragma once\n")
-           TEXT("\n")
-           TEXT("#include \"CoreMinimal.h\"\n")
-           TEXT("#include \"GameFramework/Pawn.h\"\n")
-           TEXT("#include \"InputActionValue.h\"\n")
-           TEXT("#include \"CameraPawn.generated.h\"\n")
-           TEXT("\n")
-           TEXT("class USpringArmComponent;\n")
-           TEXT("class UCameraComponent;\n")
-           TEXT("class UFloatingPawnMovement;\n")
-           TEXT("class UInputMappingContext;\n")
-           TEXT("class UInputAction;\n")
-           TEXT("\n")
-           TEXT("UCLASS()\n")
-           TEXT("class CHARACTERCREATIONCPP_API ACameraPawn : public APawn\n")
-           TEXT("{\n")
-           TEXT("    GENERATED_BODY()\n")
-           TEXT("\n")
-           TEXT("public:\n")
-           TEXT("    ACameraPawn();\n")
-           TEXT("\n")
-           TEXT("protected:\n")
-           TEXT("    virtual void BeginPlay() override;\n")
-           TEXT("    virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;\n")
-           TEXT("\n")
-           TEXT("    // Components\n")
-           TEXT("    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = \"Camera\")\n")
-           TEXT("    USpringArmComponent* SpringArmComponent;\n")
-           TEXT("\n")
-           TEXT("    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = \"Camera\")\n")
-           TEXT("    UCameraComponent* CameraComponent;\n")
-           TEXT("\n")
-           TEXT("    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = \"Movement\")\n")
-           TEXT("    UFloatingPawnMovement* FloatingPawnMovement;\n")
-           TEXT("\n")
-           TEXT("    // Input\n")
-           TEXT("    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = \"Input\")\n")
-           TEXT("    UInputMappingContext* CameraMappingContext;\n")
-           TEXT("\n")
-           TEXT("    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = \"Input\")\n")
-           TEXT("    UInputAction* ZoomAction;\n")
-           TEXT("\n")
-           TEXT("    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = \"Input\")\n")
-           TEXT("    UInputAction* RotateAction;\n")
-           TEXT("\n")
-           TEXT("    // Input callbacks\n")
-           TEXT("    void Zoom(const FInputActionValue& Value);\n")
-           TEXT("    void Rotate(const FInputActionValue& Value);\n")
-           TEXT("\n")
-           TEXT("    // Camera settings\n")
-           TEXT("    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = \"Camera\")\n")
-           TEXT("    float ZoomSpeed;\n")
-           TEXT("\n")
-           TEXT("    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = \"Camera\")\n")
-           TEXT("    float MinZoomDistance;\n")
-           TEXT("\n")
-           TEXT("    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = \"Camera\")\n")
-           TEXT("    float MaxZoomDistance;\n")
-           TEXT("\n")
-           TEXT("    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = \"Camera\")\n")
-           TEXT("    float RotationSpeed;\n")
-           TEXT("};\n");
-}
-
-FString UCameraPawnCreationCommandlet::GenerateCameraPawnCpp()
-{
-    return TEXT("#include \"CameraPawn.h\"\n")
-           TEXT("#include \"GameFramework/SpringArmComponent.h\"\n")
-           TEXT("#include \"Camera/CameraComponent.h\"\n")
-           TEXT("#include \"GameFramework/FloatingPawnMovement.h\"\n")
-           TEXT("#include \"Components/InputComponent.h\"\n")
-           TEXT("#include \"EnhancedInputComponent.h\"\n")
-           TEXT("#include \"EnhancedInputSubsystems.h\"\n")
-           TEXT("#include \"InputMappingContext.h\"\n")
-           TEXT("#include \"InputAction.h\"\n")
-           TEXT("#include \"Engine/LocalPlayer.h\"\n")
-           TEXT("#include \"GameFramework/PlayerController.h\"\n")
-           TEXT("\n")
-           TEXT("ACameraPawn::ACameraPawn()\n")
-           TEXT("{\n")
-           TEXT("    PrimaryActorTick.bCanEverTick = false;\n")
-           TEXT("\n")
-           TEXT("    // Create root component\n")
-           TEXT("    RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT(\"RootComponent\"));\n")
-           TEXT("\n")
-           TEXT("    // Create spring arm component\n")
-           TEXT("    SpringArmComponent = CreateDefaultSubobject<USpringArmComponent>(TEXT(\"SpringArm\"));\n")
-           TEXT("    SpringArmComponent->SetupAttachment(RootComponent);\n")
-           TEXT("    SpringArmComponent->TargetArmLength = 700.0f;\n")
-           TEXT("    SpringArmComponent->SetRelativeRotation(FRotator(0.0f, -60.0f, 0.0f));\n")
-           TEXT("    SpringArmComponent->bDoCollisionTest = false;\n")
-           TEXT("    SpringArmComponent->bUsePawnControlRotation = true;\n")
-           TEXT("\n")
-           TEXT("    // Create camera component\n")
-           TEXT("    CameraComponent = CreateDefaultSubobject<UCameraComponent>(TEXT(\"Camera\"));\n")
-           TEXT("    CameraComponent->SetupAttachment(SpringArmComponent, USpringArmComponent::SocketName);\n")
-           TEXT("    CameraComponent->SetProjectionMode(ECameraProjectionMode::Perspective);\n")
-           TEXT("    CameraComponent->SetFieldOfView(90.0f);\n")
-           TEXT("\n")
-           TEXT("    // Create floating pawn movement for basic movement\n")
-           TEXT("    FloatingPawnMovement = CreateDefaultSubobject<UFloatingPawnMovement>(TEXT(\"FloatingPawnMovement\"));\n")
-           TEXT("    FloatingPawnMovement->MaxSpeed = 600.0f;\n")
-           TEXT("    FloatingPawnMovement->Acceleration = 4000.0f;\n")
-           TEXT("    FloatingPawnMovement->Deceleration = 8000.0f;\n")
-           TEXT("\n")
-           TEXT("    // Set default camera settings\n")
-           TEXT("    ZoomSpeed = 50.0f;\n")
-           TEXT("    MinZoomDistance = 200.0f;\n")
-           TEXT("    MaxZoomDistance = 2000.0f;\n")
-           TEXT("    RotationSpeed = 100.0f;\n")
-           TEXT("\n")
-           TEXT("    // Load input assets\n")
-           TEXT("    static ConstructorHelpers::FObjectFinder<UInputMappingContext> MappingContextFinder(TEXT(\"/Game/Input/IMC_CameraControl\"));\n")
-           TEXT("    if (MappingContextFinder.Succeeded())\n")
-           TEXT("    {\n")
-           TEXT("        CameraMappingContext = MappingContextFinder.Object;\n")
-           TEXT("    }\n")
-           TEXT("\n")
-           TEXT("    static ConstructorHelpers::FObjectFinder<UInputAction> ZoomActionFinder(TEXT(\"/Game/Input/IA_Zoom\"));\n")
-           TEXT("    if (ZoomActionFinder.Succeeded())\n")
-           TEXT("    {\n")
-           TEXT("        ZoomAction = ZoomActionFinder.Object;\n")
-           TEXT("    }\n")
-           TEXT("\n")
-           TEXT("    static ConstructorHelpers::FObjectFinder<UInputAction> RotateActionFinder(TEXT(\"/Game/Input/IA_Rotate\"));\n")
-           TEXT("    if (RotateActionFinder.Succeeded())\n")
-           TEXT("    {\n")
-           TEXT("        RotateAction = RotateActionFinder.Object;\n")
-           TEXT("    }\n")
-           TEXT("}\n")
-           TEXT("\n")
-           TEXT("void ACameraPawn::BeginPlay()\n")
-           TEXT("{\n")
-           TEXT("    Super::BeginPlay();\n")
-           TEXT("\n")
-           TEXT("    // Add input mapping context\n")
-           TEXT("    if (APlayerController* PlayerController = Cast<APlayerController>(Controller))\n")
-           TEXT("    {\n")
-           TEXT("        if (UEnhancedInputLocalPlayerSubsystem* Subsystem = ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(PlayerController->GetLocalPlayer()))\n")
-           TEXT("        {\n")
-           TEXT("            if (CameraMappingContext)\n")
-           TEXT("            {\n")
-           TEXT("                Subsystem->AddMappingContext(CameraMappingContext, 0);\n")
-           TEXT("            }\n")
-           TEXT("        }\n")
-           TEXT("    }\n")
-           TEXT("}\n")
-           TEXT("\n")
-           TEXT("void ACameraPawn::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)\n")
-           TEXT("{\n")
-           TEXT("    Super::SetupPlayerInputComponent(PlayerInputComponent);\n")
-           TEXT("\n")
-           TEXT("    if (UEnhancedInputComponent* EnhancedInputComponent = CastChecked<UEnhancedInputComponent>(PlayerInputComponent))\n")
-           TEXT("    {\n")
-           TEXT("        // Bind zoom action\n")
-           TEXT("        if (ZoomAction)\n")
-           TEXT("        {\n")
-           TEXT("            EnhancedInputComponent->BindAction(ZoomAction, ETriggerEvent::Triggered, this, &ACameraPawn::Zoom);\n")
-           TEXT("        }\n")
-           TEXT("\n")
-           TEXT("        // Bind rotate action\n")
-           TEXT("        if (RotateAction)\n")
-           TEXT("        {\n")
-           TEXT("            EnhancedInputComponent->BindAction(RotateAction, ETriggerEvent::Triggered, this, &ACameraPawn::Rotate);\n")
-           TEXT("        }\n")
-           TEXT("    }\n")
-           TEXT("}\n")
-           TEXT("\n")
-           TEXT("void ACameraPawn::Zoom(const FInputActionValue& Value)\n")
-           TEXT("{\n")
-           TEXT("    const float ZoomValue = Value.Get<float>();\n")
-           TEXT("    \n")
-           TEXT("    if (SpringArmComponent)\n")
-           TEXT("    {\n")
-           TEXT("        float NewTargetArmLength = SpringArmComponent->TargetArmLength - (ZoomValue * ZoomSpeed);\n")
-           TEXT("        SpringArmComponent->TargetArmLength = FMath::Clamp(NewTargetArmLength, MinZoomDistance, MaxZoomDistance);\n")
-           TEXT("    }\n")
-           TEXT("}\n")
-           TEXT("\n")
-           TEXT("void ACameraPawn::Rotate(const FInputActionValue& Value)\n")
-           TEXT("{\n")
-           TEXT("    const FVector2D RotationValue = Value.Get<FVector2D>();\n")
-           TEXT("    \n")
-           TEXT("    if (Controller)\n")
-           TEXT("    {\n")
-           TEXT("        // Add yaw (horizontal) rotation\n")
-           TEXT("        AddControllerYawInput(RotationValue.X * RotationSpeed * GetWorld()->GetDeltaSeconds());\n")
-           TEXT("        \n")
-           TEXT("        // Add pitch (vertical) rotation\n")
-           TEXT("        AddControllerPitchInput(-RotationValue.Y * RotationSpeed * GetWorld()->GetDeltaSeconds());\n")
-           TEXT("    }\n")
-           TEXT("}\n");
-}
-
 bool UCameraPawnCreationCommandlet::CreateInputActions()
 {
     UE_LOG(LogCameraPawnCreation, Warning, TEXT("Creating input actions..."));
@@ -480,29 +281,17 @@ bool UCameraPawnCreationCommandlet::CreateInputMappingContext()
 #endif
 }
 
-bool UCameraPawnCreationCommandlet::WriteSourceFile(const FString& FilePath, const FString& Content)
+bool UCameraPawnCreationCommandlet::GenerateSourceFile(const FString& TemplateName, const FString& FilePath)
 {
-    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
-    
-    // Ensure directory exists
-    FString Directory = FPaths::GetPath(FilePath);
-    if (!PlatformFile.DirectoryExists(*Directory))
-    {
-        if (!PlatformFile.CreateDirectoryTree(*Directory))
-        {
-            UE_LOG(LogCameraPawnCreation, Error, TEXT("Failed to create directory: %s"), *Directory);
-            return false;
-        }
-    }
-    
-    // Write file
-    if (!FFileHelper::SaveStringToFile(Content, *FilePath))
+    bool bWritten = false;
+    FString Error;
+    if (!FSourceTemplate::Generate(TemplateName, FSourceTemplate::FArgs(), FilePath, bWritten, Error))
     {
-        UE_LOG(LogCameraPawnCreation, Error, TEXT("Failed to write file: %s"), *FilePath);
+        UE_LOG(LogCameraPawnCreation, Error, TEXT("%s"), *Error);
         return false;
     }
     
-    UE_LOG(LogCameraPawnCreation, Log, TEXT("✓ Wrote file: %s"), *FilePath);
+    UE_LOG(LogCameraPawnCreation, Log, TEXT("✓ %s file: %s"), bWritten ? TEXT("Wrote") : TEXT("Unchanged"), *FilePath);
     return true;
 }
 
@@ -19,10 +19,8 @@ private:
     bool CreateInputActions();
     bool CreateInputMappingContext();
     
-    FString GenerateCameraPawnHeader();
-    FString GenerateCameraPawnCpp();
-    
-    bool WriteSourceFile(const FString& FilePath, const FString& Content);
+    // Renders CodeTemplates/<TemplateName>.template into FilePath
+    bool GenerateSourceFile(const FString& TemplateName, const FString& FilePath);
     bool CreateInputAction(const FString& ActionName, const FString& PackagePath, uint8 ValueType);
     
     class UInputAction* ZoomAction;
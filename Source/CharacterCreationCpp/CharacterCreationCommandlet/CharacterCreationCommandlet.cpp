@@ -7,6 +7,10 @@
 #include "Misc/PackageName.h"
 #include "Engine/Engine.h"
 #include "UObject/GarbageCollection.h"
+#include "Async/Async.h"
+#include "HAL/PlatformMisc.h"
+#include "Misc/ScopeExit.h"
+#include "SpritePipelineProfiler.h"
 
 UCharacterCreationCommandlet::UCharacterCreationCommandlet()
 {
@@ -16,7 +20,7 @@ UCharacterCreationCommandlet::UCharacterCreationCommandlet()
 	LogToConsole = true;
 	ShowErrorCount = true;
 	HelpDescription = TEXT("Process sprite sheets for character creation");
-	HelpUsage = TEXT("CharacterCreationCommandlet [-texture=<TextureName>] [-batch] [-createcharacter] [-columns=<Columns>] [-rows=<Rows>] [-source=<SourcePath>] [-dest=<DestPath>]");
+	HelpUsage = TEXT("CharacterCreationCommandlet [-texture=<TextureName>] [-batch] [-createcharacter] [-columns=<Columns>] [-rows=<Rows>] [-source=<SourcePath>] [-dest=<DestPath>] [-jobs=<N>] [-atlas] [-premultiply] [-notrim] [-noshare] [-palettebase=<TextureName>] [-concurrentsave] [-force] [-report=<Path>]");
 }
 
 int32 UCharacterCreationCommandlet::Main(const FString& Params)
@@ -28,6 +32,25 @@ int32 UCharacterCreationCommandlet::Main(const FString& Params)
 	bool bBatchMode = FParse::Param(*Params, TEXT("batch"));
 	bool bCreateCharacters = FParse::Param(*Params, TEXT("createcharacter"));
 	bool bDryRun = FParse::Param(*Params, TEXT("dryrun"));
+	bool bUseSheetAtlas = FParse::Param(*Params, TEXT("atlas"));
+	bool bPremultiplyAlpha = FParse::Param(*Params, TEXT("premultiply"));
+	bool bTrimFrames = !FParse::Param(*Params, TEXT("notrim"));
+	bool bShareFrames = !FParse::Param(*Params, TEXT("noshare"));
+	bConcurrentSave = FParse::Param(*Params, TEXT("concurrentsave"));
+	bForceRebuild = FParse::Param(*Params, TEXT("force"));
+	FParse::Value(*Params, TEXT("palettebase="), PaletteBaseName);
+
+	// Stage timings and byte counts of this run, written as JSON on every exit path
+	FString ReportPath;
+	FParse::Value(*Params, TEXT("report="), ReportPath);
+	FSpritePipelineProfiler::Get().Reset();
+	ON_SCOPE_EXIT
+	{
+		if (!ReportPath.IsEmpty())
+		{
+			FSpritePipelineProfiler::Get().WriteReport(FPaths::ConvertRelativePathToFull(ReportPath));
+		}
+	};
 
 	// Parse optional parameters with defaults
 	FSpriteSheetInfo SpriteInfo;
@@ -44,6 +67,21 @@ int32 UCharacterCreationCommandlet::Main(const FString& Params)
 	FParse::Value(*Params, TEXT("dest="), DestPath);
 	FParse::Value(*Params, TEXT("d="), DestPath);
 
+	// Worker threads used to decode and slice sheets in batch mode (0 = one per core)
+	int32 NumJobs = 1;
+	FParse::Value(*Params, TEXT("jobs="), NumJobs);
+	FParse::Value(*Params, TEXT("j="), NumJobs);
+	if (NumJobs == 0)
+	{
+		NumJobs = FPlatformMisc::NumberOfCoresIncludingHyperthreads();
+	}
+
+	if (NumJobs < 0 || NumJobs > MaxJobs)
+	{
+		UE_LOG(LogCharacterCreation, Error, TEXT("Invalid job count: %d (valid range: 0-%d)"), NumJobs, MaxJobs);
+		return 1;
+	}
+
 	// Validate grid dimensions
 	if (Columns <= 0 || Columns > MaxGridDimension || Rows <= 0 || Rows > MaxGridDimension)
 	{
@@ -62,12 +100,28 @@ int32 UCharacterCreationCommandlet::Main(const FString& Params)
 	SpriteInfo.Rows = Rows;
 	SpriteInfo.SourceTexturePath = SourcePath;
 	SpriteInfo.DestinationPath = DestPath;
+	SpriteInfo.bUseSheetAtlas = bUseSheetAtlas;
+	SpriteInfo.bPremultiplyAlpha = bPremultiplyAlpha;
+	SpriteInfo.bTrimFrames = bTrimFrames;
+	SpriteInfo.bShareDuplicateFrames = bShareFrames;
+
+	if (!bDryRun)
+	{
+		Manifest.Load(FSpriteSheetManifest::GetDefaultManifestPath());
+	}
 
 	if (bBatchMode)
 	{
 		UE_LOG(LogCharacterCreation, Warning, TEXT("Running in BATCH MODE"));
 		UE_LOG(LogCharacterCreation, Warning, TEXT("Create Characters: %s"), bCreateCharacters ? TEXT("YES") : TEXT("NO"));
 		UE_LOG(LogCharacterCreation, Warning, TEXT("Dry Run: %s"), bDryRun ? TEXT("YES") : TEXT("NO"));
+		UE_LOG(LogCharacterCreation, Warning, TEXT("Jobs: %d"), NumJobs);
+		UE_LOG(LogCharacterCreation, Warning, TEXT("Sheet Atlas: %s"), bUseSheetAtlas ? TEXT("YES") : TEXT("NO"));
+		UE_LOG(LogCharacterCreation, Warning, TEXT("Premultiply Alpha: %s"), bPremultiplyAlpha ? TEXT("YES") : TEXT("NO"));
+		UE_LOG(LogCharacterCreation, Warning, TEXT("Trim Frames: %s"), bTrimFrames ? TEXT("YES") : TEXT("NO"));
+		UE_LOG(LogCharacterCreation, Warning, TEXT("Share Duplicate Frames: %s"), bShareFrames ? TEXT("YES") : TEXT("NO"));
+		UE_LOG(LogCharacterCreation, Warning, TEXT("Force Rebuild: %s"), bForceRebuild ? TEXT("YES") : TEXT("NO"));
+		UE_LOG(LogCharacterCreation, Warning, TEXT("Palette Base: %s"), PaletteBaseName.IsEmpty() ? TEXT("NONE") : *PaletteBaseName);
 		
 		// Validate asset references if creating characters
 		if (bCreateCharacters && !bDryRun && !ValidateAssetReferences())
@@ -76,7 +130,7 @@ int32 UCharacterCreationCommandlet::Main(const FString& Params)
 			return 1;
 		}
 		
-		bool bSuccess = BatchProcessSpriteSheets(SpriteInfo, bCreateCharacters, bDryRun);
+		bool bSuccess = BatchProcessSpriteSheets(SpriteInfo, bCreateCharacters, bDryRun, NumJobs);
 		
 		if (bSuccess)
 		{
@@ -108,6 +162,11 @@ int32 UCharacterCreationCommandlet::Main(const FString& Params)
 		UE_LOG(LogCharacterCreation, Warning, TEXT("Source: %s"), *SpriteInfo.SourceTexturePath);
 		UE_LOG(LogCharacterCreation, Warning, TEXT("Destination: %s"), *SpriteInfo.DestinationPath);
 		UE_LOG(LogCharacterCreation, Warning, TEXT("Dry Run: %s"), bDryRun ? TEXT("YES") : TEXT("NO"));
+		UE_LOG(LogCharacterCreation, Warning, TEXT("Sheet Atlas: %s"), bUseSheetAtlas ? TEXT("YES") : TEXT("NO"));
+		UE_LOG(LogCharacterCreation, Warning, TEXT("Premultiply Alpha: %s"), bPremultiplyAlpha ? TEXT("YES") : TEXT("NO"));
+		UE_LOG(LogCharacterCreation, Warning, TEXT("Trim Frames: %s"), bTrimFrames ? TEXT("YES") : TEXT("NO"));
+		UE_LOG(LogCharacterCreation, Warning, TEXT("Share Duplicate Frames: %s"), bShareFrames ? TEXT("YES") : TEXT("NO"));
+		UE_LOG(LogCharacterCreation, Warning, TEXT("Force Rebuild: %s"), bForceRebuild ? TEXT("YES") : TEXT("NO"));
 
 		// Validate asset references if creating characters
 		if (bCreateCharacters && !bDryRun && !ValidateAssetReferences())
@@ -125,19 +184,29 @@ int32 UCharacterCreationCommandlet::Main(const FString& Params)
 			return 0;
 		}
 
-		bool bSuccess = ProcessSpriteSheetFromCommandline(TextureName, SpriteInfo);
+		const FString RawAssetPath = FPaths::ProjectDir() + TEXT("RawAssets/") + TextureName + TEXT(".png");
+		const FString SourceHash = FSpriteSheetManifest::HashSourceFile(RawAssetPath);
+		if (IsSheetUpToDate(TextureName, SourceHash, SpriteInfo))
+		{
+			UE_LOG(LogCharacterCreation, Log, TEXT("%s is up to date, skipping (use -force to rebuild)"), *TextureName);
+			UE_LOG(LogCharacterCreation, Warning, TEXT("=== Character Creation Commandlet Completed Successfully ==="));
+			return 0;
+		}
+
+		FSpriteSheetManifestEntry Outputs;
+		bool bSuccess = ProcessSpriteSheetFromCommandline(TextureName, SpriteInfo, Outputs);
+		RecordSheetResult(TextureName, SourceHash, SpriteInfo, bSuccess, Outputs);
+		Manifest.Save();
 
 		if (bSuccess)
 		{
-			PrintSuccess(TextureName);
-			
 			// Generate character class if requested
 			if (bCreateCharacters)
 			{
 				FString CharacterName = TextureName.Replace(TEXT("_"), TEXT("")) + TEXT("Character");
 				if (GenerateCharacterClass(CharacterName, TextureName))
 				{
-					UE_LOG(LogCharacterCreation, Warning, TEXT("✓ Generated character class: %s"), *CharacterName);
+					UE_LOG(LogCharacterCreation, Verbose, TEXT("Generated character class: %s"), *CharacterName);
 				}
 			}
 			
@@ -156,29 +225,174 @@ int32 UCharacterCreationCommandlet::Main(const FString& Params)
 	}
 }
 
-bool UCharacterCreationCommandlet::ProcessSpriteSheetFromCommandline(const FString& TextureName, const FSpriteSheetInfo& SpriteInfo)
+USpriteSheetProcessor* UCharacterCreationCommandlet::CreateProcessor()
 {
-	UE_LOG(LogCharacterCreation, Warning, TEXT("Creating USpriteSheetProcessor instance..."));
 	USpriteSheetProcessor* Processor = NewObject<USpriteSheetProcessor>(GetTransientPackage());
-	
 	if (!Processor)
 	{
 		UE_LOG(LogCharacterCreation, Error, TEXT("CRITICAL ERROR: Failed to create USpriteSheetProcessor instance"));
+		return nullptr;
+	}
+
+	Processor->bConcurrentSave = bConcurrentSave;
+	Processor->SetSharedFrameCache(&FrameCache);
+	return Processor;
+}
+
+void UCharacterCreationCommandlet::CollectProcessorOutputs(const USpriteSheetProcessor* Processor, FSpriteSheetManifestEntry& OutOutputs) const
+{
+	OutOutputs.OutputPackages = Processor->GetGeneratedPackageNames();
+
+	// Borrowed sprites are rewritten whenever their owner is, so remember which build of the owner they came from
+	OutOutputs.Dependencies.Reset();
+	for (const FString& OwnerSheet : Processor->GetBorrowedSheetNames())
+	{
+		OutOutputs.Dependencies.Add(OwnerSheet, Manifest.GetSourceHash(OwnerSheet));
+	}
+}
+
+bool UCharacterCreationCommandlet::ProcessSpriteSheetFromCommandline(const FString& TextureName, const FSpriteSheetInfo& SpriteInfo, FSpriteSheetManifestEntry& OutOutputs)
+{
+	USpriteSheetProcessor* Processor = CreateProcessor();
+	if (!Processor)
+	{
 		return false;
 	}
-	
-	UE_LOG(LogCharacterCreation, Warning, TEXT("USpriteSheetProcessor instance created successfully"));
 
-	UE_LOG(LogCharacterCreation, Warning, TEXT("About to call ProcessSpriteSheet(\"%s\", SpriteInfo)..."), *TextureName);
-	
-	bool bSuccess = false;
-	UE_LOG(LogCharacterCreation, Warning, TEXT("CALLING Processor->ProcessSpriteSheet now..."));
-	bSuccess = Processor->ProcessSpriteSheet(TextureName, SpriteInfo);
-	UE_LOG(LogCharacterCreation, Warning, TEXT("ProcessSpriteSheet call returned: %s"), bSuccess ? TEXT("TRUE") : TEXT("FALSE"));
+	bool bSuccess = Processor->ProcessSpriteSheet(TextureName, SpriteInfo);
+
+	CollectProcessorOutputs(Processor, OutOutputs);
+	return bSuccess;
+}
+
+bool UCharacterCreationCommandlet::ProcessDecodedSpriteSheetFromCommandline(const FString& TextureName, FDecodedSpriteSheet& DecodedSheet, const FSpriteSheetInfo& SpriteInfo, FSpriteSheetManifestEntry& OutOutputs)
+{
+	USpriteSheetProcessor* Processor = CreateProcessor();
+	if (!Processor)
+	{
+		return false;
+	}
+
+	bool bSuccess = Processor->ProcessDecodedSpriteSheet(TextureName, DecodedSheet, SpriteInfo);
 
+	CollectProcessorOutputs(Processor, OutOutputs);
 	return bSuccess;
 }
 
+bool UCharacterCreationCommandlet::ProcessPaletteGroupFromCommandline(const FString& BaseTextureName, const TArray<FString>& TextureNames, const FSpriteSheetInfo& SpriteInfo, TArray<FString>& OutPaletteMembers, bool& bOutUpToDate)
+{
+	OutPaletteMembers.Reset();
+	bOutUpToDate = false;
+
+	if (!TextureNames.Contains(BaseTextureName))
+	{
+		UE_LOG(LogCharacterCreation, Error, TEXT("Palette base %s.png was not found in RawAssets"), *BaseTextureName);
+		return false;
+	}
+
+	TArray<FString> Variants = TextureNames;
+	Variants.Remove(BaseTextureName);
+
+	// Any candidate changing can change which variants are recolors, so the group is hashed as a whole
+	const FString IndexedName = FSpritePalette::GetIndexedSheetName(BaseTextureName);
+	const FString GroupHash = FSpriteSheetManifest::HashPaletteGroup(BaseTextureName, Variants, SpriteInfo);
+	if (IsSheetUpToDate(IndexedName, GroupHash, SpriteInfo))
+	{
+		const FSpriteSheetManifestEntry* Entry = Manifest.Find(IndexedName);
+		if (Entry->PaletteMembers.Num() > 0)
+		{
+			OutPaletteMembers = Entry->PaletteMembers;
+			bOutUpToDate = true;
+			UE_LOG(LogCharacterCreation, Verbose, TEXT("Palette group %s is up to date, skipping"), *BaseTextureName);
+			return true;
+		}
+	}
+
+	USpriteSheetProcessor* Processor = CreateProcessor();
+	if (!Processor)
+	{
+		return false;
+	}
+
+	UE_LOG(LogCharacterCreation, Verbose, TEXT("Building palette group for %s with %d candidate variants"), *BaseTextureName, Variants.Num());
+
+	TArray<FString> FallbackVariants;
+	if (!Processor->ProcessPaletteVariants(BaseTextureName, Variants, SpriteInfo, FallbackVariants))
+	{
+		UE_LOG(LogCharacterCreation, Error, TEXT("Palette group for %s failed, processing every sheet normally"), *BaseTextureName);
+		Manifest.Remove(IndexedName);
+		return false;
+	}
+
+	OutPaletteMembers.Add(BaseTextureName);
+	for (const FString& Variant : Variants)
+	{
+		if (!FallbackVariants.Contains(Variant))
+		{
+			OutPaletteMembers.Add(Variant);
+		}
+	}
+
+	FSpriteSheetManifestEntry Outputs;
+	CollectProcessorOutputs(Processor, Outputs);
+	for (const FString& Member : OutPaletteMembers)
+	{
+		Outputs.OutputPackages.Add(FSpritePalette::GetPaletteTexturePath(Member));
+	}
+	if (GroupHash.IsEmpty())
+	{
+		Manifest.Remove(IndexedName);
+	}
+	else
+	{
+		Manifest.Record(IndexedName, GroupHash, SpriteInfo, Outputs.OutputPackages, Outputs.Dependencies, OutPaletteMembers);
+		RebuiltSheets.Add(IndexedName);
+	}
+
+	UE_LOG(LogCharacterCreation, Verbose, TEXT("Palette group %s: %s"), *BaseTextureName, *FString::Join(OutPaletteMembers, TEXT(", ")));
+	return true;
+}
+
+bool UCharacterCreationCommandlet::IsSheetUpToDate(const FString& TextureName, const FString& SourceHash, const FSpriteSheetInfo& SpriteInfo) const
+{
+	if (bForceRebuild || SourceHash.IsEmpty())
+	{
+		return false;
+	}
+
+	const FSpriteSheetManifestEntry* Entry = Manifest.FindReusableEntry(TextureName, SpriteInfo);
+	if (!Entry || Entry->SourceHash != SourceHash)
+	{
+		return false;
+	}
+
+	// An owner rebuilt earlier in this run rewrote the sprites this sheet references, even if its PNG did not change
+	for (const TPair<FString, FString>& Dependency : Entry->Dependencies)
+	{
+		if (RebuiltSheets.Contains(Dependency.Key))
+		{
+			UE_LOG(LogCharacterCreation, Log, TEXT("%s borrows frames from %s, which was rebuilt, rebuilding"), *TextureName, *Dependency.Key);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void UCharacterCreationCommandlet::RecordSheetResult(const FString& TextureName, const FString& SourceHash, const FSpriteSheetInfo& SpriteInfo, bool bSuccess, const FSpriteSheetManifestEntry& Outputs)
+{
+	// A failed or partial build must not be mistaken for an up to date one next run
+	if (bSuccess && !SourceHash.IsEmpty())
+	{
+		Manifest.Record(TextureName, SourceHash, SpriteInfo, Outputs.OutputPackages, Outputs.Dependencies);
+		RebuiltSheets.Add(TextureName);
+	}
+	else
+	{
+		Manifest.Remove(TextureName);
+	}
+}
+
 void UCharacterCreationCommandlet::PrintUsage() const
 {
 	UE_LOG(LogCharacterCreation, Warning, TEXT(""));
@@ -195,37 +409,78 @@ void UCharacterCreationCommandlet::PrintUsage() const
 	UE_LOG(LogCharacterCreation, Warning, TEXT("  -rows=<num>      | -r=<num>      Number of rows (default: %d)"), DefaultRows);
 	UE_LOG(LogCharacterCreation, Warning, TEXT("  -source=<path>   | -s=<path>     Source texture path (default: /Game/RawAssets/)"));
 	UE_LOG(LogCharacterCreation, Warning, TEXT("  -dest=<path>     | -d=<path>     Destination path (default: /Game/Sprites/)"));
+	UE_LOG(LogCharacterCreation, Warning, TEXT("  -jobs=<num>      | -j=<num>      Batch mode: decode sheets on N worker threads (default: 1, 0 = all cores)"));
+	UE_LOG(LogCharacterCreation, Warning, TEXT("  -atlas                           Sprites share the sheet texture instead of one texture per cell"));
+	UE_LOG(LogCharacterCreation, Warning, TEXT("  -premultiply                     Premultiply color by alpha while slicing"));
+	UE_LOG(LogCharacterCreation, Warning, TEXT("  -notrim                          Keep full cells instead of cropping frames to their visible pixels"));
+	UE_LOG(LogCharacterCreation, Warning, TEXT("  -noshare                         Create a sprite for every cell even when frames are identical"));
+	UE_LOG(LogCharacterCreation, Warning, TEXT("  -concurrentsave                  Write each sheet's packages with a concurrent batched save"));
+	UE_LOG(LogCharacterCreation, Warning, TEXT("  -force                           Rebuild sheets even if the manifest says they are up to date"));
+	UE_LOG(LogCharacterCreation, Warning, TEXT("  -report=<Path>                   Write per-stage timings and byte counts of the run as JSON"));
+	UE_LOG(LogCharacterCreation, Warning, TEXT("  -palettebase=<name>              Batch mode: store recolors of this sheet as palette textures"));
+	UE_LOG(LogCharacterCreation, Warning, TEXT(""));
+	UE_LOG(LogCharacterCreation, Warning, TEXT("Animations come from RawAssets/<TextureName>.layout.json when it exists,"));
+	UE_LOG(LogCharacterCreation, Warning, TEXT("otherwise one warrior animation per row (Idle, Move, AttackSideways, ...)."));
 	UE_LOG(LogCharacterCreation, Warning, TEXT(""));
 	UE_LOG(LogCharacterCreation, Warning, TEXT("Examples:"));
 	UE_LOG(LogCharacterCreation, Warning, TEXT("  CharacterCreationCommandlet -texture=Warrior_Blue"));
 	UE_LOG(LogCharacterCreation, Warning, TEXT("  CharacterCreationCommandlet -batch -createcharacter"));
 	UE_LOG(LogCharacterCreation, Warning, TEXT("  CharacterCreationCommandlet -t=Warrior_Blue -c=6 -r=8 -createcharacter"));
 	UE_LOG(LogCharacterCreation, Warning, TEXT("  CharacterCreationCommandlet -batch -dryrun"));
+	UE_LOG(LogCharacterCreation, Warning, TEXT("  CharacterCreationCommandlet -batch -jobs=0"));
+	UE_LOG(LogCharacterCreation, Warning, TEXT("  CharacterCreationCommandlet -t=Warrior_Blue -atlas"));
+	UE_LOG(LogCharacterCreation, Warning, TEXT("  CharacterCreationCommandlet -batch -force"));
 	UE_LOG(LogCharacterCreation, Warning, TEXT(""));
 }
 
-void UCharacterCreationCommandlet::PrintSuccess(const FString& TextureName) const
+void UCharacterCreationCommandlet::SortSheetsByDependency(TArray<FString>& PNGFiles) const
 {
-	UE_LOG(LogCharacterCreation, Warning, TEXT(""));
-	UE_LOG(LogCharacterCreation, Warning, TEXT("✓ SUCCESS! Sprite sheet processed successfully"));
-	UE_LOG(LogCharacterCreation, Warning, TEXT(""));
-	UE_LOG(LogCharacterCreation, Warning, TEXT("Generated Assets:"));
-	UE_LOG(LogCharacterCreation, Warning, TEXT("━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━"));
-	UE_LOG(LogCharacterCreation, Warning, TEXT("📁 Sprites: /Game/Sprites/ (48 individual sprites)"));
-	UE_LOG(LogCharacterCreation, Warning, TEXT("🎬 Animations: /Game/Animations/ (8 flipbook animations)"));
-	UE_LOG(LogCharacterCreation, Warning, TEXT(""));
-	UE_LOG(LogCharacterCreation, Warning, TEXT("Animation Details:"));
-	UE_LOG(LogCharacterCreation, Warning, TEXT("━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━"));
-	UE_LOG(LogCharacterCreation, Warning, TEXT("🏃 1. Idle (6 frames @ 12fps)"));
-	UE_LOG(LogCharacterCreation, Warning, TEXT("🚶 2. Move (6 frames @ 12fps)"));
-	UE_LOG(LogCharacterCreation, Warning, TEXT("⚔️  3. AttackSideways (6 frames @ 12fps)"));
-	UE_LOG(LogCharacterCreation, Warning, TEXT("⚔️  4. AttackSideways2 (6 frames @ 12fps)"));
-	UE_LOG(LogCharacterCreation, Warning, TEXT("🗡️  5. AttackDownwards (6 frames @ 12fps)"));
-	UE_LOG(LogCharacterCreation, Warning, TEXT("🗡️  6. AttackDownwards2 (6 frames @ 12fps)"));
-	UE_LOG(LogCharacterCreation, Warning, TEXT("⬆️  7. AttackUpwards (6 frames @ 12fps)"));
-	UE_LOG(LogCharacterCreation, Warning, TEXT("⬆️  8. AttackUpwards2 (6 frames @ 12fps)"));
-	UE_LOG(LogCharacterCreation, Warning, TEXT(""));
-	UE_LOG(LogCharacterCreation, Warning, TEXT("📋 Check the Content Browser to see all generated assets!"));
+	// FindFiles order is unspecified. Owners have to come first: a borrower is only checked against
+	// its owner's new source hash, and the frame cache only lends frames the run has already created.
+	PNGFiles.Sort();
+
+	TMap<FString, FString> FilesByName;
+	for (const FString& PNGFile : PNGFiles)
+	{
+		FilesByName.Add(FPaths::GetBaseFilename(PNGFile), PNGFile);
+	}
+
+	TArray<FString> Ordered;
+	Ordered.Reserve(PNGFiles.Num());
+	TSet<FString> Visited;
+
+	TFunction<void(const FString&)> Visit = [&](const FString& TextureName)
+	{
+		bool bAlreadyVisited = false;
+		Visited.Add(TextureName, &bAlreadyVisited);
+		if (bAlreadyVisited)
+		{
+			return;
+		}
+
+		if (const FSpriteSheetManifestEntry* Entry = Manifest.Find(TextureName))
+		{
+			TArray<FString> Owners;
+			Entry->Dependencies.GetKeys(Owners);
+			Owners.Sort();
+			for (const FString& Owner : Owners)
+			{
+				if (FilesByName.Contains(Owner))
+				{
+					Visit(Owner);
+				}
+			}
+		}
+
+		Ordered.Add(FilesByName[TextureName]);
+	};
+
+	for (const FString& PNGFile : PNGFiles)
+	{
+		Visit(FPaths::GetBaseFilename(PNGFile));
+	}
+
+	PNGFiles = MoveTemp(Ordered);
 }
 
 void UCharacterCreationCommandlet::PrintFailure(const FString& TextureName) const
@@ -241,7 +496,7 @@ void UCharacterCreationCommandlet::PrintFailure(const FString& TextureName) cons
 	UE_LOG(LogCharacterCreation, Error, TEXT("4. Verify grid dimensions match the texture"));
 }
 
-bool UCharacterCreationCommandlet::BatchProcessSpriteSheets(const FSpriteSheetInfo& SpriteInfo, bool bCreateCharacters, bool bDryRun)
+bool UCharacterCreationCommandlet::BatchProcessSpriteSheets(const FSpriteSheetInfo& SpriteInfo, bool bCreateCharacters, bool bDryRun, int32 NumJobs)
 {
 	UE_LOG(LogCharacterCreation, Warning, TEXT(""));
 	UE_LOG(LogCharacterCreation, Warning, TEXT("=== Starting Batch Processing ==="));
@@ -260,6 +515,7 @@ bool UCharacterCreationCommandlet::BatchProcessSpriteSheets(const FSpriteSheetIn
 	}
 	
 	UE_LOG(LogCharacterCreation, Warning, TEXT("Found %d PNG files to process"), PNGFiles.Num());
+	SortSheetsByDependency(PNGFiles);
 	
 	// Handle dry run mode
 	if (bDryRun)
@@ -274,25 +530,160 @@ bool UCharacterCreationCommandlet::BatchProcessSpriteSheets(const FSpriteSheetIn
 	}
 	
 	TArray<FString> ProcessedTextures;
+	TArray<FString> SkippedTextures;
 	TArray<FString> GeneratedCharacters;
 	bool bAllSuccessful = true;
+
+	// Recolors of the palette base share one index sheet, so they leave the regular per-sheet loop.
+	// Variants that are not pure recolors stay in the loop.
+	if (!PaletteBaseName.IsEmpty())
+	{
+		TArray<FString> TextureNames;
+		for (const FString& PNGFile : PNGFiles)
+		{
+			TextureNames.Add(FPaths::GetBaseFilename(PNGFile));
+		}
+
+		TArray<FString> PaletteMembers;
+		bool bPaletteUpToDate = false;
+		if (!ProcessPaletteGroupFromCommandline(PaletteBaseName, TextureNames, SpriteInfo, PaletteMembers, bPaletteUpToDate))
+		{
+			bAllSuccessful = false;
+		}
+
+		PNGFiles.RemoveAll([&PaletteMembers](const FString& PNGFile)
+		{
+			return PaletteMembers.Contains(FPaths::GetBaseFilename(PNGFile));
+		});
+
+		for (const FString& TextureName : PaletteMembers)
+		{
+			if (bPaletteUpToDate)
+			{
+				SkippedTextures.Add(TextureName);
+				continue;
+			}
+
+			ProcessedTextures.Add(TextureName);
+			if (bCreateCharacters)
+			{
+				FString CharacterName = TextureName.Replace(TEXT("_"), TEXT("")) + TEXT("Character");
+				if (GenerateCharacterClass(CharacterName, TextureName, PaletteBaseName))
+				{
+					GeneratedCharacters.Add(CharacterName);
+					UE_LOG(LogCharacterCreation, Verbose, TEXT("Generated character class: %s"), *CharacterName);
+				}
+				else
+				{
+					UE_LOG(LogCharacterCreation, Error, TEXT("✗ Failed to generate character class: %s"), *CharacterName);
+					bAllSuccessful = false;
+				}
+			}
+		}
+	}
+
+	// With -jobs=N, PNG decode and cell slicing run on the thread pool while the game thread
+	// creates and saves assets for sheets that are already decoded. At most NumJobs sheets
+	// are in flight so memory stays bounded regardless of the batch size.
+	const bool bParallel = NumJobs > 1 && PNGFiles.Num() > 1;
+	TArray<TFuture<TSharedPtr<FDecodedSpriteSheet>>> PendingDecodes;
+	int32 NextFileToDecode = 0;
+
+	auto LaunchNextDecode = [this, &PNGFiles, &PendingDecodes, &NextFileToDecode, &SpriteInfo]()
+	{
+		const FString TextureName = FPaths::GetBaseFilename(PNGFiles[NextFileToDecode++]);
+		const FString RawAssetPath = FPaths::ProjectDir() + TEXT("RawAssets/") + TextureName + TEXT(".png");
+
+		// Resolved on the game thread so workers only compare hashes and never touch the manifest
+		const FSpriteSheetManifestEntry* Entry = bForceRebuild ? nullptr : Manifest.FindReusableEntry(TextureName, SpriteInfo);
+		const FString ReusableHash = Entry ? Entry->SourceHash : FString();
+
+		PendingDecodes.Add(Async(EAsyncExecution::ThreadPool, [TextureName, RawAssetPath, SpriteInfo, ReusableHash]()
+		{
+			TSharedPtr<FDecodedSpriteSheet> DecodedSheet = MakeShared<FDecodedSpriteSheet>();
+			DecodedSheet->TextureName = TextureName;
+
+			if (!ReusableHash.IsEmpty() && FSpriteSheetManifest::HashSourceFile(RawAssetPath) == ReusableHash)
+			{
+				DecodedSheet->SourceHash = ReusableHash;
+				DecodedSheet->bUpToDate = true;
+				return DecodedSheet;
+			}
+
+			USpriteSheetProcessor::DecodeSpriteSheet(RawAssetPath, SpriteInfo, *DecodedSheet);
+			return DecodedSheet;
+		}));
+	};
+
+	if (bParallel)
+	{
+		UE_LOG(LogCharacterCreation, Warning, TEXT("Decoding on %d worker threads"), NumJobs);
+		USpriteSheetProcessor::PreloadDecoderModules();
+
+		while (NextFileToDecode < PNGFiles.Num() && PendingDecodes.Num() < NumJobs)
+		{
+			LaunchNextDecode();
+		}
+	}
 	
 	// Process each PNG file
 	for (const FString& PNGFile : PNGFiles)
 	{
 		FString TextureName = FPaths::GetBaseFilename(PNGFile);
 		
-		UE_LOG(LogCharacterCreation, Warning, TEXT(""));
-		UE_LOG(LogCharacterCreation, Warning, TEXT("━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━"));
-		UE_LOG(LogCharacterCreation, Warning, TEXT("Processing: %s"), *TextureName);
-		UE_LOG(LogCharacterCreation, Warning, TEXT("━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━"));
+		UE_LOG(LogCharacterCreation, Verbose, TEXT("Processing: %s"), *TextureName);
 		
-		bool bSuccess = ProcessSpriteSheetFromCommandline(TextureName, SpriteInfo);
+		bool bSuccess = false;
+		FString SourceHash;
+		FSpriteSheetManifestEntry Outputs;
+		if (bParallel)
+		{
+			// Futures are consumed in launch order, which matches PNGFiles order
+			TSharedPtr<FDecodedSpriteSheet> DecodedSheet = PendingDecodes[0].Get();
+			PendingDecodes.RemoveAt(0);
+
+			if (NextFileToDecode < PNGFiles.Num())
+			{
+				LaunchNextDecode();
+			}
+
+			SourceHash = DecodedSheet->SourceHash;
+			if (DecodedSheet->bUpToDate)
+			{
+				// Checked again here because a sheet it borrows frames from may have been rebuilt since the launch
+				if (IsSheetUpToDate(TextureName, SourceHash, SpriteInfo))
+				{
+					UE_LOG(LogCharacterCreation, Verbose, TEXT("%s is up to date, skipping"), *TextureName);
+					SkippedTextures.Add(TextureName);
+					continue;
+				}
+
+				bSuccess = ProcessSpriteSheetFromCommandline(TextureName, SpriteInfo, Outputs);
+			}
+			else
+			{
+				bSuccess = ProcessDecodedSpriteSheetFromCommandline(TextureName, *DecodedSheet, SpriteInfo, Outputs);
+			}
+		}
+		else
+		{
+			const FString RawAssetPath = FPaths::ProjectDir() + TEXT("RawAssets/") + TextureName + TEXT(".png");
+			SourceHash = FSpriteSheetManifest::HashSourceFile(RawAssetPath);
+			if (IsSheetUpToDate(TextureName, SourceHash, SpriteInfo))
+			{
+				UE_LOG(LogCharacterCreation, Verbose, TEXT("%s is up to date, skipping"), *TextureName);
+				SkippedTextures.Add(TextureName);
+				continue;
+			}
+
+			bSuccess = ProcessSpriteSheetFromCommandline(TextureName, SpriteInfo, Outputs);
+		}
+
+		RecordSheetResult(TextureName, SourceHash, SpriteInfo, bSuccess, Outputs);
 		
 		if (bSuccess)
 		{
 			ProcessedTextures.Add(TextureName);
-			PrintSuccess(TextureName);
 			
 			// Generate character class if requested
 			if (bCreateCharacters)
@@ -301,7 +692,7 @@ bool UCharacterCreationCommandlet::BatchProcessSpriteSheets(const FSpriteSheetIn
 				if (GenerateCharacterClass(CharacterName, TextureName))
 				{
 					GeneratedCharacters.Add(CharacterName);
-					UE_LOG(LogCharacterCreation, Warning, TEXT("✓ Generated character class: %s"), *CharacterName);
+					UE_LOG(LogCharacterCreation, Verbose, TEXT("Generated character class: %s"), *CharacterName);
 				}
 				else
 				{
@@ -317,8 +708,10 @@ bool UCharacterCreationCommandlet::BatchProcessSpriteSheets(const FSpriteSheetIn
 		}
 	}
 	
+	Manifest.Save();
+
 	// Print summary
-	PrintBatchSummary(ProcessedTextures, GeneratedCharacters);
+	PrintBatchSummary(ProcessedTextures, SkippedTextures, GeneratedCharacters);
 	
 	// Clean up memory after batch processing
 	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
@@ -326,134 +719,51 @@ bool UCharacterCreationCommandlet::BatchProcessSpriteSheets(const FSpriteSheetIn
 	return bAllSuccessful;
 }
 
-bool UCharacterCreationCommandlet::GenerateCharacterClass(const FString& CharacterName, const FString& TextureName)
+bool UCharacterCreationCommandlet::GenerateCharacterClass(const FString& CharacterName, const FString& TextureName, const FString& PaletteBaseName)
 {
-	UE_LOG(LogCharacterCreation, Warning, TEXT(""));
-	UE_LOG(LogCharacterCreation, Warning, TEXT("Generating character class: %s"), *CharacterName);
-	
-	bool bHeaderSuccess = WriteCharacterHeaderFile(CharacterName, TextureName);
-	bool bSourceSuccess = WriteCharacterSourceFile(CharacterName, TextureName);
-	
-	if (bHeaderSuccess && bSourceSuccess)
-	{
-		UE_LOG(LogCharacterCreation, Warning, TEXT("✓ Successfully generated %s.h and %s.cpp"), *CharacterName, *CharacterName);
-		UE_LOG(LogCharacterCreation, Warning, TEXT("  NOTE: Project must be recompiled for new classes to be available"));
-		return true;
-	}
-	
-	return false;
-}
+	UE_LOG(LogCharacterCreation, Verbose, TEXT("Generating character class: %s"), *CharacterName);
 
-bool UCharacterCreationCommandlet::WriteCharacterHeaderFile(const FString& CharacterName, const FString& TextureName)
-{
 	FString SourceDir = FPaths::ProjectDir() / TEXT("Source/CharacterCreationCpp/");
 	if (!FPaths::DirectoryExists(SourceDir))
 	{
 		UE_LOG(LogCharacterCreation, Error, TEXT("Source directory does not exist: %s"), *SourceDir);
 		return false;
 	}
+
+	// Palette members prefer the shared index animations and keep their own as the fallback
+	FSourceTemplate::FArgs Args;
+	Args.Add(TEXT("ClassName"), CharacterName);
+	Args.Add(TEXT("SheetName"), TextureName);
+	Args.Add(TEXT("PaletteBaseName"), PaletteBaseName);
 	
-	FString FilePath = SourceDir / CharacterName + TEXT(".h");
-	
-	FString HeaderContent = FString::Printf(TEXT(
-		"// Generated character class for %s\n"
-		"#pragma once\n"
-		"\n"
-		"#include \"CoreMinimal.h\"\n"
-		"#include \"WarriorCharacter.h\"\n"
-		"#include \"%s.generated.h\"\n"
-		"\n"
-		"UCLASS()\n"
-		"class CHARACTERCREATIONCPP_API A%s : public AWarriorCharacter\n"
-		"{\n"
-		"	GENERATED_BODY()\n"
-		"\n"
-		"public:\n"
-		"	A%s();\n"
-		"\n"
-		"protected:\n"
-		"	virtual void LoadAnimationsForCharacter() override;\n"
-		"};\n"
-	), *TextureName, *CharacterName, *CharacterName, *CharacterName);
+	bool bHeaderSuccess = WriteCharacterFile(TEXT("WarriorCharacter.h"), Args, SourceDir / CharacterName + TEXT(".h"));
+	bool bSourceSuccess = WriteCharacterFile(TEXT("WarriorCharacter.cpp"), Args, SourceDir / CharacterName + TEXT(".cpp"));
 	
-	if (FFileHelper::SaveStringToFile(HeaderContent, *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	if (bHeaderSuccess && bSourceSuccess)
 	{
-		UE_LOG(LogCharacterCreation, Log, TEXT("Created header file: %s"), *FilePath);
+		UE_LOG(LogCharacterCreation, Log, TEXT("Generated %s.h and %s.cpp"), *CharacterName, *CharacterName);
+		UE_LOG(LogCharacterCreation, Warning, TEXT("  NOTE: Project must be recompiled for new classes to be available"));
 		return true;
 	}
-	else
-	{
-		UE_LOG(LogCharacterCreation, Error, TEXT("Failed to create header file: %s"), *FilePath);
-		return false;
-	}
+	
+	return false;
 }
 
-bool UCharacterCreationCommandlet::WriteCharacterSourceFile(const FString& CharacterName, const FString& TextureName)
+bool UCharacterCreationCommandlet::WriteCharacterFile(const FString& TemplateName, const FSourceTemplate::FArgs& Args, const FString& FilePath) const
 {
-	FString SourceDir = FPaths::ProjectDir() / TEXT("Source/CharacterCreationCpp/");
-	if (!FPaths::DirectoryExists(SourceDir))
+	bool bWritten = false;
+	FString Error;
+	if (!FSourceTemplate::Generate(TemplateName, Args, FilePath, bWritten, Error))
 	{
-		UE_LOG(LogCharacterCreation, Error, TEXT("Source directory does not exist: %s"), *SourceDir);
-		return false;
-	}
-	
-	FString FilePath = SourceDir / CharacterName + TEXT(".cpp");
-	
-	TStringBuilder<2048> SourceContent;
-	SourceContent.Appendf(TEXT("// Generated character class for %s\n"), *TextureName);
-	SourceContent.Appendf(TEXT("#include \"%s.h\"\n"), *CharacterName);
-	SourceContent.Append(TEXT("#include \"PaperFlipbook.h\"\n"));
-	SourceContent.Append(TEXT("#include \"PaperFlipbookComponent.h\"\n"));
-	SourceContent.Append(TEXT("#include \"CharacterCreationLog.h\"\n"));
-	SourceContent.Append(TEXT("\n"));
-	SourceContent.Appendf(TEXT("A%s::A%s()\n"), *CharacterName, *CharacterName);
-	SourceContent.Append(TEXT("{\n"));
-	SourceContent.Append(TEXT("	// Character is already set up by parent class\n"));
-	SourceContent.Append(TEXT("	// Load animations in constructor for editor preview\n"));
-	SourceContent.Append(TEXT("	LoadAnimationsForCharacter();\n"));
-	SourceContent.Append(TEXT("}\n"));
-	SourceContent.Append(TEXT("\n"));
-	SourceContent.Appendf(TEXT("void A%s::LoadAnimationsForCharacter()\n"), *CharacterName);
-	SourceContent.Append(TEXT("{\n"));
-	SourceContent.Appendf(TEXT("	UE_LOG(LogCharacterCreation, Warning, TEXT(\"Loading animations for %s\"));\n"), *CharacterName);
-	SourceContent.Append(TEXT("	\n"));
-	SourceContent.Appendf(TEXT("	// Load animations specific to %s\n"), *TextureName);
-	SourceContent.Appendf(TEXT("	IdleAnimation = LoadObject<UPaperFlipbook>(nullptr, TEXT(\"/Game/Animations/Idle_%s\"));\n"), *TextureName);
-	SourceContent.Appendf(TEXT("	MoveAnimation = LoadObject<UPaperFlipbook>(nullptr, TEXT(\"/Game/Animations/Move_%s\"));\n"), *TextureName);
-	SourceContent.Appendf(TEXT("	AttackUpAnimation = LoadObject<UPaperFlipbook>(nullptr, TEXT(\"/Game/Animations/AttackUpwards_%s\"));\n"), *TextureName);
-	SourceContent.Appendf(TEXT("	AttackDownAnimation = LoadObject<UPaperFlipbook>(nullptr, TEXT(\"/Game/Animations/AttackDownwards_%s\"));\n"), *TextureName);
-	SourceContent.Appendf(TEXT("	AttackSideAnimation = LoadObject<UPaperFlipbook>(nullptr, TEXT(\"/Game/Animations/AttackSideways_%s\"));\n"), *TextureName);
-	SourceContent.Appendf(TEXT("	AttackUp2Animation = LoadObject<UPaperFlipbook>(nullptr, TEXT(\"/Game/Animations/AttackUpwards2_%s\"));\n"), *TextureName);
-	SourceContent.Appendf(TEXT("	AttackDown2Animation = LoadObject<UPaperFlipbook>(nullptr, TEXT(\"/Game/Animations/AttackDownwards2_%s\"));\n"), *TextureName);
-	SourceContent.Appendf(TEXT("	AttackSide2Animation = LoadObject<UPaperFlipbook>(nullptr, TEXT(\"/Game/Animations/AttackSideways2_%s\"));\n"), *TextureName);
-	SourceContent.Append(TEXT("	\n"));
-	SourceContent.Append(TEXT("	// Set initial animation\n"));
-	SourceContent.Append(TEXT("	if (GetSprite() && IdleAnimation)\n"));
-	SourceContent.Append(TEXT("	{\n"));
-	SourceContent.Append(TEXT("		GetSprite()->SetFlipbook(IdleAnimation);\n"));
-	SourceContent.Appendf(TEXT("		UE_LOG(LogCharacterCreation, Warning, TEXT(\"✓ Set initial animation for %s\"));\n"), *CharacterName);
-	SourceContent.Append(TEXT("	}\n"));
-	SourceContent.Append(TEXT("	else\n"));
-	SourceContent.Append(TEXT("	{\n"));
-	SourceContent.Append(TEXT("		UE_LOG(LogCharacterCreation, Warning, TEXT(\"Failed to set animation - Sprite: %s, IdleAnimation: %s\"),\n"));
-	SourceContent.Append(TEXT("			GetSprite() ? TEXT(\"Valid\") : TEXT(\"NULL\"),\n"));
-	SourceContent.Append(TEXT("			IdleAnimation ? TEXT(\"Valid\") : TEXT(\"NULL\"));\n"));
-	SourceContent.Append(TEXT("	}\n"));
-	SourceContent.Append(TEXT("}\n"));
-	
-	if (FFileHelper::SaveStringToFile(SourceContent.ToString(), *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
-	{
-		UE_LOG(LogCharacterCreation, Log, TEXT("Created source file: %s"), *FilePath);
-		return true;
-	}
-	else
-	{
-		UE_LOG(LogCharacterCreation, Error, TEXT("Failed to create source file: %s"), *FilePath);
+		UE_LOG(LogCharacterCreation, Error, TEXT("Failed to generate %s: %s"), *FilePath, *Error);
 		return false;
 	}
+
+	UE_LOG(LogCharacterCreation, Log, TEXT("%s file: %s"), bWritten ? TEXT("Created") : TEXT("Unchanged"), *FilePath);
+	return true;
 }
 
-void UCharacterCreationCommandlet::PrintBatchSummary(const TArray<FString>& ProcessedTextures, const TArray<FString>& GeneratedCharacters) const
+void UCharacterCreationCommandlet::PrintBatchSummary(const TArray<FString>& ProcessedTextures, const TArray<FString>& SkippedTextures, const TArray<FString>& GeneratedCharacters) const
 {
 	UE_LOG(LogCharacterCreation, Warning, TEXT(""));
 	UE_LOG(LogCharacterCreation, Warning, TEXT("════════════════════════════════════════════════════"));
@@ -467,6 +777,16 @@ void UCharacterCreationCommandlet::PrintBatchSummary(const TArray<FString>& Proc
 		UE_LOG(LogCharacterCreation, Warning, TEXT("  ✓ %s"), *Texture);
 	}
 	
+	if (SkippedTextures.Num() > 0)
+	{
+		UE_LOG(LogCharacterCreation, Warning, TEXT(""));
+		UE_LOG(LogCharacterCreation, Warning, TEXT("Up To Date, Skipped (%d):"), SkippedTextures.Num());
+		for (const FString& Texture : SkippedTextures)
+		{
+			UE_LOG(LogCharacterCreation, Warning, TEXT("  = %s"), *Texture);
+		}
+	}
+	
 	if (GeneratedCharacters.Num() > 0)
 	{
 		UE_LOG(LogCharacterCreation, Warning, TEXT(""));
@@ -3,6 +3,8 @@
 #include "CoreMinimal.h"
 #include "Commandlets/Commandlet.h"
 #include "SpriteSheetProcessor.h"
+#include "SpriteSheetManifest.h"
+#include "SourceTemplate.h"
 #include "CharacterCreationCommandlet.generated.h"
 
 UCLASS()
@@ -19,25 +21,55 @@ public:
 	static constexpr int32 DefaultColumns = 6;
 	static constexpr int32 DefaultRows = 8;
 	static constexpr int32 MaxGridDimension = 100;
+	static constexpr int32 MaxJobs = 64;
 
 private:
 	// Single sprite processing
-	bool ProcessSpriteSheetFromCommandline(const FString& TextureName, const FSpriteSheetInfo& SpriteInfo);
+	// OutOutputs receives the generated packages and the sheets the result borrows frames from
+	bool ProcessSpriteSheetFromCommandline(const FString& TextureName, const FSpriteSheetInfo& SpriteInfo, FSpriteSheetManifestEntry& OutOutputs);
+	bool ProcessDecodedSpriteSheetFromCommandline(const FString& TextureName, FDecodedSpriteSheet& DecodedSheet, const FSpriteSheetInfo& SpriteInfo, FSpriteSheetManifestEntry& OutOutputs);
+	USpriteSheetProcessor* CreateProcessor();
+	void CollectProcessorOutputs(const USpriteSheetProcessor* Processor, FSpriteSheetManifestEntry& OutOutputs) const;
+
+	// Palette swap: OutPaletteMembers receives the base and every variant that became a palette.
+	// The group is recorded in the manifest under its index sheet and skipped while no member PNG changed.
+	bool ProcessPaletteGroupFromCommandline(const FString& BaseTextureName, const TArray<FString>& TextureNames, const FSpriteSheetInfo& SpriteInfo, TArray<FString>& OutPaletteMembers, bool& bOutUpToDate);
+
+	// Incremental processing
+	bool IsSheetUpToDate(const FString& TextureName, const FString& SourceHash, const FSpriteSheetInfo& SpriteInfo) const;
+	void RecordSheetResult(const FString& TextureName, const FString& SourceHash, const FSpriteSheetInfo& SpriteInfo, bool bSuccess, const FSpriteSheetManifestEntry& Outputs);
+
+	// Name order, except that a sheet follows every sheet its last build borrowed frames from
+	void SortSheetsByDependency(TArray<FString>& PNGFiles) const;
 	
 	// Batch processing
-	bool BatchProcessSpriteSheets(const FSpriteSheetInfo& SpriteInfo, bool bCreateCharacters, bool bDryRun = false);
+	bool BatchProcessSpriteSheets(const FSpriteSheetInfo& SpriteInfo, bool bCreateCharacters, bool bDryRun = false, int32 NumJobs = 1);
 	
 	// Character generation
-	bool GenerateCharacterClass(const FString& CharacterName, const FString& TextureName);
-	bool WriteCharacterHeaderFile(const FString& CharacterName, const FString& TextureName);
-	bool WriteCharacterSourceFile(const FString& CharacterName, const FString& TextureName);
+	bool GenerateCharacterClass(const FString& CharacterName, const FString& TextureName, const FString& PaletteBaseName = FString());
+	bool WriteCharacterFile(const FString& TemplateName, const FSourceTemplate::FArgs& Args, const FString& FilePath) const;
 	
 	// Utility
 	void PrintUsage() const;
-	void PrintSuccess(const FString& TextureName) const;
 	void PrintFailure(const FString& TextureName) const;
-	void PrintBatchSummary(const TArray<FString>& ProcessedTextures, const TArray<FString>& GeneratedCharacters) const;
+	void PrintBatchSummary(const TArray<FString>& ProcessedTextures, const TArray<FString>& SkippedTextures, const TArray<FString>& GeneratedCharacters) const;
 	bool ValidateAndSanitizePath(FString& Path) const;
 	bool ValidateAssetReferences() const;
 	void PrintDryRunSummary(const TArray<FString>& FilesToProcess) const;
+
+	// Passed to every USpriteSheetProcessor this commandlet creates
+	bool bConcurrentSave = false;
+
+	// Sheets whose PNG and settings match the manifest are skipped unless -force is given
+	FSpriteSheetManifest Manifest;
+	bool bForceRebuild = false;
+
+	// Sheets rebuilt in this run; sheets borrowing their sprites cannot be skipped
+	TSet<FString> RebuiltSheets;
+
+	// Batch mode: recolors of this sheet are stored as palettes instead of full sprite sets
+	FString PaletteBaseName;
+
+	// Shared by every processor of a run so identical frames across sheets become one sprite
+	FSpriteFrameCache FrameCache;
 };
\ No newline at end of file
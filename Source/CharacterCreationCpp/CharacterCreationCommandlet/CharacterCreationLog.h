@@ -1,5 +1,38 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "HAL/PlatformTime.h"
 
-DECLARE_LOG_CATEGORY_EXTERN(LogCharacterCreation, Log, All);
\ No newline at end of file
+// Most verbose LogCharacterCreation level compiled in; anything above it is stripped along with its
+// format arguments. Tiers: Log for per-sheet and per-class summaries, Verbose for per-asset detail,
+// VeryVerbose for per-frame gameplay traces. Development keeps everything but VeryVerbose.
+#ifndef CHARACTER_CREATION_COMPILE_VERBOSITY
+	#if UE_BUILD_SHIPPING
+		#define CHARACTER_CREATION_COMPILE_VERBOSITY Warning
+	#elif UE_BUILD_TEST
+		#define CHARACTER_CREATION_COMPILE_VERBOSITY Log
+	#elif UE_BUILD_DEVELOPMENT
+		#define CHARACTER_CREATION_COMPILE_VERBOSITY Verbose
+	#else
+		#define CHARACTER_CREATION_COMPILE_VERBOSITY All
+	#endif
+#endif
+
+DECLARE_LOG_CATEGORY_EXTERN(LogCharacterCreation, Log, CHARACTER_CREATION_COMPILE_VERBOSITY);
+
+// UE_LOG for per-frame paths: each call site logs at most once every IntervalSeconds. Compiled out
+// with the verbosity, and the clock is only read when the verbosity is enabled at runtime.
+#define UE_LOG_CHARACTER_CREATION_THROTTLED(Verbosity, IntervalSeconds, Format, ...) \
+	do \
+	{ \
+		if (UE_LOG_ACTIVE(LogCharacterCreation, Verbosity)) \
+		{ \
+			static double LastLogSeconds = -DBL_MAX; \
+			const double NowSeconds = FPlatformTime::Seconds(); \
+			if (NowSeconds - LastLogSeconds >= (IntervalSeconds)) \
+			{ \
+				LastLogSeconds = NowSeconds; \
+				UE_LOG(LogCharacterCreation, Verbosity, Format, ##__VA_ARGS__); \
+			} \
+		} \
+	} while (false)
@@ -0,0 +1,107 @@
+#include "PaperPropertyBindings.h"
+#include "CharacterCreationLog.h"
+#include "Engine/Texture2D.h"
+#include "PaperSprite.h"
+
+namespace
+{
+	template <typename PropertyType>
+	PropertyType* FindTypedProperty(UClass* Class, const TCHAR* Name)
+	{
+		FProperty* Property = Class->FindPropertyByName(Name);
+		if (!Property)
+		{
+			UE_LOG(LogCharacterCreation, Error, TEXT("%s::%s not found - the Paper2D layout changed"), *Class->GetName(), Name);
+			return nullptr;
+		}
+
+		PropertyType* TypedProperty = CastField<PropertyType>(Property);
+		if (!TypedProperty)
+		{
+			UE_LOG(LogCharacterCreation, Error, TEXT("%s::%s is a %s, expected %s - the Paper2D layout changed"),
+				*Class->GetName(), Name, *Property->GetClass()->GetName(), *PropertyType::StaticClass()->GetName());
+		}
+		return TypedProperty;
+	}
+
+	bool IsStructOf(const FStructProperty* Property, const UScriptStruct* Expected)
+	{
+		if (Property && Property->Struct != Expected)
+		{
+			UE_LOG(LogCharacterCreation, Error, TEXT("%s holds %s, expected %s - the Paper2D layout changed"),
+				*Property->GetName(), *Property->Struct->GetName(), *Expected->GetName());
+			return false;
+		}
+		return Property != nullptr;
+	}
+}
+
+const FPaperPropertyBindings* FPaperPropertyBindings::Get()
+{
+	static FPaperPropertyBindings Bindings;
+	static const bool bBound = Bindings.Bind();
+	return bBound ? &Bindings : nullptr;
+}
+
+bool FPaperPropertyBindings::Bind()
+{
+	UClass* SpriteClass = UPaperSprite::StaticClass();
+	UClass* FlipbookClass = UPaperFlipbook::StaticClass();
+
+	SourceTextureProperty = FindTypedProperty<FSoftObjectProperty>(SpriteClass, TEXT("SourceTexture"));
+	SourceUVProperty = FindTypedProperty<FStructProperty>(SpriteClass, TEXT("SourceUV"));
+	SourceDimensionProperty = FindTypedProperty<FStructProperty>(SpriteClass, TEXT("SourceDimension"));
+	KeyFramesProperty = FindTypedProperty<FArrayProperty>(FlipbookClass, TEXT("KeyFrames"));
+	FramesPerSecondProperty = FindTypedProperty<FFloatProperty>(FlipbookClass, TEXT("FramesPerSecond"));
+
+	bool bValid = SourceTextureProperty && KeyFramesProperty && FramesPerSecondProperty;
+	bValid &= IsStructOf(SourceUVProperty, TBaseStructure<FVector2D>::Get());
+	bValid &= IsStructOf(SourceDimensionProperty, TBaseStructure<FVector2D>::Get());
+
+	if (SourceTextureProperty && !UTexture2D::StaticClass()->IsChildOf(SourceTextureProperty->PropertyClass))
+	{
+		UE_LOG(LogCharacterCreation, Error, TEXT("UPaperSprite::SourceTexture cannot hold a UTexture2D - the Paper2D layout changed"));
+		bValid = false;
+	}
+
+	if (KeyFramesProperty)
+	{
+		const FStructProperty* InnerProperty = CastField<FStructProperty>(KeyFramesProperty->Inner);
+		if (!InnerProperty || InnerProperty->Struct != FPaperFlipbookKeyFrame::StaticStruct())
+		{
+			UE_LOG(LogCharacterCreation, Error, TEXT("UPaperFlipbook::KeyFrames is not an array of FPaperFlipbookKeyFrame - the Paper2D layout changed"));
+			bValid = false;
+		}
+	}
+
+	if (bValid)
+	{
+		UE_LOG(LogCharacterCreation, Log, TEXT("Bound Paper2D sprite and flipbook properties"));
+	}
+	return bValid;
+}
+
+TSoftObjectPtr<UTexture2D>& FPaperPropertyBindings::SourceTexture(UPaperSprite* Sprite) const
+{
+	return *SourceTextureProperty->ContainerPtrToValuePtr<TSoftObjectPtr<UTexture2D>>(Sprite);
+}
+
+FVector2D& FPaperPropertyBindings::SourceUV(UPaperSprite* Sprite) const
+{
+	return *SourceUVProperty->ContainerPtrToValuePtr<FVector2D>(Sprite);
+}
+
+FVector2D& FPaperPropertyBindings::SourceDimension(UPaperSprite* Sprite) const
+{
+	return *SourceDimensionProperty->ContainerPtrToValuePtr<FVector2D>(Sprite);
+}
+
+TArray<FPaperFlipbookKeyFrame>& FPaperPropertyBindings::KeyFrames(UPaperFlipbook* Flipbook) const
+{
+	return *KeyFramesProperty->ContainerPtrToValuePtr<TArray<FPaperFlipbookKeyFrame>>(Flipbook);
+}
+
+float& FPaperPropertyBindings::FramesPerSecond(UPaperFlipbook* Flipbook) const
+{
+	return *FramesPerSecondProperty->ContainerPtrToValuePtr<float>(Flipbook);
+}
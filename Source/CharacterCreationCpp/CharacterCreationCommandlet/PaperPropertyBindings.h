@@ -0,0 +1,38 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PaperFlipbook.h"
+#include "UObject/SoftObjectPtr.h"
+
+class UPaperSprite;
+class UTexture2D;
+
+/**
+ * Typed access to the protected Paper2D fields the sprite pipeline writes.
+ *
+ * The properties are looked up and type-checked once per process. If the engine layout no longer
+ * matches, Get() logs which field broke and returns null, so callers can stop before creating any
+ * asset instead of producing half-initialized sprites.
+ */
+class CHARACTERCREATIONCPP_API FPaperPropertyBindings
+{
+public:
+	// Resolved on first use; thread-safe, but meant to be called from the game thread like the asset code
+	static const FPaperPropertyBindings* Get();
+
+	TSoftObjectPtr<UTexture2D>& SourceTexture(UPaperSprite* Sprite) const;
+	FVector2D& SourceUV(UPaperSprite* Sprite) const;
+	FVector2D& SourceDimension(UPaperSprite* Sprite) const;
+
+	TArray<FPaperFlipbookKeyFrame>& KeyFrames(UPaperFlipbook* Flipbook) const;
+	float& FramesPerSecond(UPaperFlipbook* Flipbook) const;
+
+private:
+	bool Bind();
+
+	FSoftObjectProperty* SourceTextureProperty = nullptr;
+	FStructProperty* SourceUVProperty = nullptr;
+	FStructProperty* SourceDimensionProperty = nullptr;
+	FArrayProperty* KeyFramesProperty = nullptr;
+	FFloatProperty* FramesPerSecondProperty = nullptr;
+};
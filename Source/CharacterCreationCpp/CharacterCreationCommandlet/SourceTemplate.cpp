@@ -0,0 +1,359 @@
+#include "SourceTemplate.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+TSharedPtr<const FSourceTemplate> FSourceTemplate::Find(const FString& TemplateName, FString& OutError)
+{
+	// Commandlets generate on the game thread only. Failures are cached too, so a broken template is
+	// reported once per class instead of being reloaded.
+	static TMap<FString, TPair<TSharedPtr<const FSourceTemplate>, FString>> Cache;
+
+	if (const TPair<TSharedPtr<const FSourceTemplate>, FString>* Cached = Cache.Find(TemplateName))
+	{
+		OutError = Cached->Value;
+		return Cached->Key;
+	}
+
+	TPair<TSharedPtr<const FSourceTemplate>, FString>& Entry = Cache.Add(TemplateName);
+
+	const FString FilePath = GetTemplateDir() / TemplateName + TEXT(".template");
+	FString Text;
+	if (!FFileHelper::LoadFileToString(Text, *FilePath))
+	{
+		Entry.Value = FString::Printf(TEXT("Template not found: %s"), *FilePath);
+		OutError = Entry.Value;
+		return nullptr;
+	}
+
+	TSharedRef<FSourceTemplate> Template = MakeShared<FSourceTemplate>();
+	Template->Name = TemplateName;
+	if (!Template->Parse(Text, TemplateName.EndsWith(TEXT(".h")), Entry.Value))
+	{
+		Entry.Value = FString::Printf(TEXT("%s: %s"), *TemplateName, *Entry.Value);
+		OutError = Entry.Value;
+		return nullptr;
+	}
+
+	Entry.Key = Template;
+	return Template;
+}
+
+FString FSourceTemplate::GetTemplateDir()
+{
+	return FPaths::ProjectDir() / TEXT("CodeTemplates");
+}
+
+bool FSourceTemplate::Generate(const FString& TemplateName, const FArgs& Args, const FString& FilePath, bool& bOutWritten, FString& OutError)
+{
+	bOutWritten = false;
+
+	const TSharedPtr<const FSourceTemplate> Template = Find(TemplateName, OutError);
+	FString Text;
+	return Template && Template->Render(Args, Text, OutError) && WriteSourceFile(FilePath, Text, bOutWritten, OutError);
+}
+
+bool FSourceTemplate::Parse(const FString& Text, bool bIsHeader, FString& OutError)
+{
+	enum class ELexState : uint8
+	{
+		Code,
+		LineComment,
+		BlockComment,
+		String,
+		Char
+	};
+
+	struct FOpenSection
+	{
+		int32 SegmentIndex;
+		int32 BracketDepth;
+		ELexState State;
+	};
+
+	ELexState State = ELexState::Code;
+	TArray<TCHAR, TInlineAllocator<32>> Brackets;
+	TArray<FOpenSection, TInlineAllocator<4>> OpenSections;
+	FString Literal;
+	int32 Line = 1;
+
+	auto FlushLiteral = [this, &Literal]()
+	{
+		if (!Literal.IsEmpty())
+		{
+			FSegment& Segment = Segments.AddDefaulted_GetRef();
+			Segment.Text = MoveTemp(Literal);
+			LiteralLength += Segment.Text.Len();
+			Literal.Reset();
+		}
+	};
+
+	for (int32 Index = 0; Index < Text.Len(); Index++)
+	{
+		const TCHAR Char = Text[Index];
+		const TCHAR Next = Index + 1 < Text.Len() ? Text[Index + 1] : TEXT('\0');
+
+		// Tags: {{Name}}, {{?Name}} and {{/Name}}. Anything else between braces is ordinary text.
+		if (Char == TEXT('{') && Next == TEXT('{'))
+		{
+			const int32 Close = Text.Find(TEXT("}}"), ESearchCase::CaseSensitive, ESearchDir::FromStart, Index + 2);
+			const FString Tag = Close != INDEX_NONE ? Text.Mid(Index + 2, Close - Index - 2) : FString();
+			const TCHAR Kind = Tag.Len() > 1 && (Tag[0] == TEXT('?') || Tag[0] == TEXT('/')) ? Tag[0] : TEXT('\0');
+			const FString TagName = Kind != TEXT('\0') ? Tag.Mid(1) : Tag;
+			if (IsIdentifier(TagName))
+			{
+				FlushLiteral();
+				if (Kind == TEXT('?'))
+				{
+					OpenSections.Add({ Segments.Num(), Brackets.Num(), State });
+					FSegment& Segment = Segments.AddDefaulted_GetRef();
+					Segment.Type = ESegmentType::Section;
+					Segment.Text = TagName;
+				}
+				else if (Kind == TEXT('/'))
+				{
+					if (OpenSections.Num() == 0 || Segments[OpenSections.Last().SegmentIndex].Text != TagName)
+					{
+						OutError = FString::Printf(TEXT("line %d: {{/%s}} does not close the open section"), Line, *TagName);
+						return false;
+					}
+					const FOpenSection Open = OpenSections.Pop();
+					if (Open.BracketDepth != Brackets.Num() || Open.State != State)
+					{
+						OutError = FString::Printf(TEXT("line %d: section %s leaves a bracket, string or comment open"), Line, *TagName);
+						return false;
+					}
+					Segments[Open.SegmentIndex].SectionEnd = Segments.Num();
+				}
+				else
+				{
+					if (State == ELexState::Char)
+					{
+						OutError = FString::Printf(TEXT("line %d: {{%s}} inside a character literal"), Line, *TagName);
+						return false;
+					}
+					FSegment& Segment = Segments.AddDefaulted_GetRef();
+					Segment.Type = ESegmentType::Value;
+					Segment.Text = TagName;
+					Segment.Context = State == ELexState::String ? EValueContext::String
+						: State == ELexState::Code ? EValueContext::Code : EValueContext::Comment;
+				}
+				Index = Close + 1;
+				continue;
+			}
+		}
+
+		Literal.AppendChar(Char);
+		if (Char == TEXT('\n'))
+		{
+			Line++;
+		}
+
+		switch (State)
+		{
+		case ELexState::Code:
+			if (Char == TEXT('/') && (Next == TEXT('/') || Next == TEXT('*')))
+			{
+				State = Next == TEXT('/') ? ELexState::LineComment : ELexState::BlockComment;
+				Literal.AppendChar(Next);
+				Index++;
+			}
+			else if (Char == TEXT('"') || Char == TEXT('\''))
+			{
+				State = Char == TEXT('"') ? ELexState::String : ELexState::Char;
+			}
+			else if (Char == TEXT('(') || Char == TEXT('[') || Char == TEXT('{'))
+			{
+				Brackets.Add(Char);
+			}
+			else if (Char == TEXT(')') || Char == TEXT(']') || Char == TEXT('}'))
+			{
+				const TCHAR Expected = Char == TEXT(')') ? TEXT('(') : Char == TEXT(']') ? TEXT('[') : TEXT('{');
+				if (Brackets.Num() == 0 || Brackets.Pop() != Expected)
+				{
+					OutError = FString::Printf(TEXT("line %d: unbalanced '%c'"), Line, Char);
+					return false;
+				}
+				if (OpenSections.Num() > 0 && Brackets.Num() < OpenSections.Last().BracketDepth)
+				{
+					OutError = FString::Printf(TEXT("line %d: '%c' closes a bracket opened before section %s"), Line, Char, *Segments[OpenSections.Last().SegmentIndex].Text);
+					return false;
+				}
+			}
+			break;
+
+		case ELexState::LineComment:
+			if (Char == TEXT('\n'))
+			{
+				State = ELexState::Code;
+			}
+			break;
+
+		case ELexState::BlockComment:
+			if (Char == TEXT('*') && Next == TEXT('/'))
+			{
+				State = ELexState::Code;
+				Literal.AppendChar(Next);
+				Index++;
+			}
+			break;
+
+		case ELexState::String:
+		case ELexState::Char:
+			if (Char == TEXT('\\') && Next != TEXT('\0'))
+			{
+				Literal.AppendChar(Next);
+				Index++;
+			}
+			else if (Char == (State == ELexState::String ? TEXT('"') : TEXT('\'')))
+			{
+				State = ELexState::Code;
+			}
+			else if (Char == TEXT('\n'))
+			{
+				OutError = FString::Printf(TEXT("line %d: unterminated literal"), Line - 1);
+				return false;
+			}
+			break;
+		}
+	}
+	FlushLiteral();
+
+	if (State != ELexState::Code && State != ELexState::LineComment)
+	{
+		OutError = TEXT("unterminated literal or comment at end of file");
+		return false;
+	}
+	if (Brackets.Num() > 0)
+	{
+		OutError = FString::Printf(TEXT("%d unclosed brackets at end of file"), Brackets.Num());
+		return false;
+	}
+	if (OpenSections.Num() > 0)
+	{
+		OutError = FString::Printf(TEXT("section %s is never closed"), *Segments[OpenSections.Last().SegmentIndex].Text);
+		return false;
+	}
+
+	if (bIsHeader)
+	{
+		if (!Text.Contains(TEXT("#pragma once")))
+		{
+			OutError = TEXT("header has no #pragma once");
+			return false;
+		}
+
+		// UHT requires the generated header to be included, and included last
+		const int32 GeneratedInclude = Text.Find(TEXT(".generated.h\""));
+		if (GeneratedInclude == INDEX_NONE && Text.Contains(TEXT("GENERATED_BODY")))
+		{
+			OutError = TEXT("GENERATED_BODY without a .generated.h include");
+			return false;
+		}
+		if (GeneratedInclude != INDEX_NONE && Text.Find(TEXT("#include"), ESearchCase::CaseSensitive, ESearchDir::FromStart, GeneratedInclude) != INDEX_NONE)
+		{
+			OutError = TEXT("the .generated.h include must be the last include");
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool FSourceTemplate::Render(const FArgs& Args, FString& OutText, FString& OutError) const
+{
+	OutText.Reset(LiteralLength + 256);
+
+	for (int32 Index = 0; Index < Segments.Num();)
+	{
+		const FSegment& Segment = Segments[Index];
+		if (Segment.Type == ESegmentType::Text)
+		{
+			OutText += Segment.Text;
+			Index++;
+			continue;
+		}
+
+		const FString* Value = Args.Find(Segment.Text);
+		if (Segment.Type == ESegmentType::Section)
+		{
+			Index = Value && !Value->IsEmpty() ? Index + 1 : Segment.SectionEnd;
+			continue;
+		}
+
+		if (!Value)
+		{
+			OutError = FString::Printf(TEXT("%s: no value for {{%s}}"), *Name, *Segment.Text);
+			return false;
+		}
+		if (!IsValidValue(*Value, Segment.Context))
+		{
+			static const TCHAR* ContextNames[] = { TEXT("an identifier"), TEXT("string literal text"), TEXT("comment text") };
+			OutError = FString::Printf(TEXT("%s: \"%s\" is not valid as {{%s}}, which must be %s"),
+				*Name, **Value, *Segment.Text, ContextNames[static_cast<int32>(Segment.Context)]);
+			return false;
+		}
+		OutText += *Value;
+		Index++;
+	}
+
+	return true;
+}
+
+bool FSourceTemplate::WriteSourceFile(const FString& FilePath, const FString& Text, bool& bOutWritten, FString& OutError)
+{
+	bOutWritten = false;
+
+	IFileManager& FileManager = IFileManager::Get();
+	FString ExistingText;
+	if (FileManager.FileExists(*FilePath) && FFileHelper::LoadFileToString(ExistingText, *FilePath) && ExistingText.Equals(Text, ESearchCase::CaseSensitive))
+	{
+		return true;
+	}
+
+	const FString Directory = FPaths::GetPath(FilePath);
+	if (!FileManager.DirectoryExists(*Directory) && !FileManager.MakeDirectory(*Directory, true))
+	{
+		OutError = FString::Printf(TEXT("Failed to create directory: %s"), *Directory);
+		return false;
+	}
+
+	if (!FFileHelper::SaveStringToFile(Text, *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	{
+		OutError = FString::Printf(TEXT("Failed to write file: %s"), *FilePath);
+		return false;
+	}
+
+	bOutWritten = true;
+	return true;
+}
+
+bool FSourceTemplate::IsIdentifier(const FString& Value)
+{
+	if (Value.IsEmpty() || FChar::IsDigit(Value[0]))
+	{
+		return false;
+	}
+
+	for (const TCHAR Char : Value)
+	{
+		if (!(FChar::IsAlnum(Char) && Char < 128) && Char != TEXT('_'))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool FSourceTemplate::IsValidValue(const FString& Value, EValueContext Context)
+{
+	switch (Context)
+	{
+	case EValueContext::Code:
+		return IsIdentifier(Value);
+	case EValueContext::String:
+		return !Value.Contains(TEXT("\"")) && !Value.Contains(TEXT("\\")) && !Value.Contains(TEXT("\n")) && !Value.Contains(TEXT("\r"));
+	default:
+		return !Value.Contains(TEXT("\n")) && !Value.Contains(TEXT("\r")) && !Value.Contains(TEXT("*/"));
+	}
+}
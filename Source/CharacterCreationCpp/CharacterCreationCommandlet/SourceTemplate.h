@@ -0,0 +1,68 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * A C++ source template from CodeTemplates/, shared by the class generating commandlets.
+ *
+ * {{Name}} is replaced by a value; {{?Name}}...{{/Name}} is kept only when Name has a non-empty value.
+ * Templates are checked once when loaded: brackets balance, strings and comments are terminated,
+ * sections do not change the nesting, and a header's .generated.h include comes last. Rendering then
+ * only has to keep each value inside its token (an identifier in code, no quotes or backslashes in a
+ * string, no line break in a comment), so the output compiles whenever the template does.
+ */
+class CHARACTERCREATIONCPP_API FSourceTemplate
+{
+public:
+	using FArgs = TMap<FString, FString>;
+
+	// Loads and checks CodeTemplates/<TemplateName>.template on first use and caches the parse for the
+	// rest of the run. Returns null with OutError set if the file is missing or fails the check.
+	static TSharedPtr<const FSourceTemplate> Find(const FString& TemplateName, FString& OutError);
+
+	static FString GetTemplateDir();
+
+	// Find, Render and WriteSourceFile in one call: renders TemplateName with Args into FilePath
+	static bool Generate(const FString& TemplateName, const FArgs& Args, const FString& FilePath, bool& bOutWritten, FString& OutError);
+
+	bool Render(const FArgs& Args, FString& OutText, FString& OutError) const;
+
+	// Leaves FilePath untouched when it already holds Text, so regenerating an unchanged class keeps
+	// its timestamp and UBT does not recompile it
+	static bool WriteSourceFile(const FString& FilePath, const FString& Text, bool& bOutWritten, FString& OutError);
+
+private:
+	enum class ESegmentType : uint8
+	{
+		Text,
+		Value,
+		Section
+	};
+
+	// Where a value lands, which decides what it may contain
+	enum class EValueContext : uint8
+	{
+		Code,
+		String,
+		Comment
+	};
+
+	struct FSegment
+	{
+		ESegmentType Type = ESegmentType::Text;
+		EValueContext Context = EValueContext::Code;
+		// Literal text, or the placeholder name
+		FString Text;
+		// Sections: index of the first segment after {{/Name}}
+		int32 SectionEnd = INDEX_NONE;
+	};
+
+	bool Parse(const FString& Text, bool bIsHeader, FString& OutError);
+
+	static bool IsIdentifier(const FString& Value);
+	static bool IsValidValue(const FString& Value, EValueContext Context);
+
+	FString Name;
+	TArray<FSegment> Segments;
+	int32 LiteralLength = 0;
+};
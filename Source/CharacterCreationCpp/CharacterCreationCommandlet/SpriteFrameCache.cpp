@@ -0,0 +1,50 @@
+#include "SpriteFrameCache.h"
+#include "Hash/xxhash.h"
+#include "PaperSprite.h"
+
+FSpriteFrameHash FSpriteFrameCache::HashFrame(const uint8* PixelData, int32 ImageWidth, int32 StartX, int32 StartY,
+	const FIntRect& TrimRect, const FIntPoint& CellSize)
+{
+	const int32 Geometry[6] = { TrimRect.Min.X, TrimRect.Min.Y, TrimRect.Width(), TrimRect.Height(), CellSize.X, CellSize.Y };
+
+	FXxHash128Builder Builder;
+	Builder.Update(Geometry, sizeof(Geometry));
+
+	const int64 Stride = int64(ImageWidth) * 4;
+	const int64 RowBytes = int64(TrimRect.Width()) * 4;
+	for (int32 Y = 0; Y < TrimRect.Height(); ++Y)
+	{
+		Builder.Update(PixelData + (StartY + Y) * Stride + int64(StartX) * 4, RowBytes);
+	}
+
+	const FXxHash128 Hash = Builder.Finalize();
+
+	FSpriteFrameHash Result;
+	Result.Low = Hash.HashLow;
+	Result.High = Hash.HashHigh;
+	return Result;
+}
+
+UPaperSprite* FSpriteFrameCache::Find(const FSpriteFrameHash& Hash, FString* OutOwnerSheet) const
+{
+	const FCachedFrame* Frame = Frames.Find(Hash);
+	if (!Frame)
+	{
+		return nullptr;
+	}
+
+	UPaperSprite* Sprite = Frame->Sprite.Get();
+	if (Sprite && OutOwnerSheet)
+	{
+		*OutOwnerSheet = Frame->OwnerSheet;
+	}
+
+	return Sprite;
+}
+
+void FSpriteFrameCache::Add(const FSpriteFrameHash& Hash, UPaperSprite* Sprite, const FString& OwnerSheet)
+{
+	FCachedFrame& Frame = Frames.FindOrAdd(Hash);
+	Frame.Sprite = Sprite;
+	Frame.OwnerSheet = OwnerSheet;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class UPaperSprite;
+
+/** 128-bit content hash of one sliced frame: its pixels, trim rectangle and cell size. */
+struct FSpriteFrameHash
+{
+	uint64 Low = 0;
+	uint64 High = 0;
+
+	bool operator==(const FSpriteFrameHash& Other) const { return Low == Other.Low && High == Other.High; }
+	bool operator!=(const FSpriteFrameHash& Other) const { return !(*this == Other); }
+
+	friend uint32 GetTypeHash(const FSpriteFrameHash& Hash) { return static_cast<uint32>(Hash.Low); }
+};
+
+/**
+ * Maps frame content to the sprite already created for it, so identical cells within a sheet
+ * or across the sheets of one run resolve to a single UPaperSprite.
+ */
+class CHARACTERCREATIONCPP_API FSpriteFrameCache
+{
+public:
+	// Hashes a BGRA8 region. Two frames only match if they would render identically around the
+	// same pivot, so the trim rectangle and the untrimmed cell size are part of the hash.
+	// Pure function, safe to call from worker threads.
+	static FSpriteFrameHash HashFrame(const uint8* PixelData, int32 ImageWidth, int32 StartX, int32 StartY,
+		const FIntRect& TrimRect, const FIntPoint& CellSize);
+
+	// Returns the sprite for this content, or null. OutOwnerSheet names the sheet that created it.
+	UPaperSprite* Find(const FSpriteFrameHash& Hash, FString* OutOwnerSheet = nullptr) const;
+	void Add(const FSpriteFrameHash& Hash, UPaperSprite* Sprite, const FString& OwnerSheet);
+
+	int32 Num() const { return Frames.Num(); }
+	void Reset() { Frames.Reset(); }
+
+private:
+	struct FCachedFrame
+	{
+		TWeakObjectPtr<UPaperSprite> Sprite;
+		FString OwnerSheet;
+	};
+
+	TMap<FSpriteFrameHash, FCachedFrame> Frames;
+};
@@ -0,0 +1,177 @@
+#include "SpritePackageSaveQueue.h"
+#include "CharacterCreationLog.h"
+#include "SpritePipelineProfiler.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+
+bool FSpritePackageSaveQueue::Enqueue(UPackage* Package, UObject* Asset)
+{
+	check(IsInGameThread());
+
+	if (!Package || !Asset)
+	{
+		return false;
+	}
+
+	FPendingSave Save;
+	Save.Package = Package;
+	Save.Asset = Asset;
+	Save.Filename = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension());
+
+	if (!IsBatching())
+	{
+		TArray<FPendingSave> Saves;
+		Saves.Add(MoveTemp(Save));
+		return SavePackages(Saves, false);
+	}
+
+	// A package touched twice in one batch is only written once
+	FPendingSave* Existing = PendingSaves.FindByPredicate([Package](const FPendingSave& Pending) { return Pending.Package == Package; });
+	if (Existing)
+	{
+		Existing->Asset = Asset;
+	}
+	else
+	{
+		PendingSaves.Add(MoveTemp(Save));
+	}
+
+	return true;
+}
+
+void FSpritePackageSaveQueue::BeginBatch()
+{
+	++BatchDepth;
+}
+
+bool FSpritePackageSaveQueue::EndBatch(bool bConcurrent)
+{
+	check(BatchDepth > 0);
+
+	if (--BatchDepth > 0)
+	{
+		return true;
+	}
+
+	if (bDiscardBatch)
+	{
+		DropPendingSaves();
+		return false;
+	}
+
+	TArray<FPendingSave> Saves = MoveTemp(PendingSaves);
+	PendingSaves.Reset();
+	return SavePackages(Saves, bConcurrent);
+}
+
+void FSpritePackageSaveQueue::DiscardBatch()
+{
+	check(BatchDepth > 0);
+
+	if (--BatchDepth > 0)
+	{
+		bDiscardBatch = true;
+		return;
+	}
+
+	DropPendingSaves();
+}
+
+void FSpritePackageSaveQueue::DropPendingSaves()
+{
+	UE_LOG(LogCharacterCreation, Warning, TEXT("Discarded save batch: %d packages left unwritten"), PendingSaves.Num());
+	PendingSaves.Reset();
+	bDiscardBatch = false;
+}
+
+bool FSpritePackageSaveQueue::SavePackages(TArray<FPendingSave>& Saves, bool bConcurrent)
+{
+	if (Saves.Num() == 0)
+	{
+		return true;
+	}
+
+	SPRITE_PIPELINE_SCOPE(Save);
+
+	const double StartTime = FPlatformTime::Seconds();
+	int32 NumFailed = 0;
+
+	if (bConcurrent && Saves.Num() > 1)
+	{
+		TArray<FPackageSaveInfo> SaveInfos;
+		SaveInfos.Reserve(Saves.Num());
+		for (const FPendingSave& Save : Saves)
+		{
+			FPackageSaveInfo& Info = SaveInfos.AddDefaulted_GetRef();
+			Info.Package = Save.Package;
+			Info.Asset = Save.Asset;
+			Info.Filename = Save.Filename;
+		}
+
+		FSavePackageArgs SaveArgs;
+		SaveArgs.TopLevelFlags = EObjectFlags::RF_Public | EObjectFlags::RF_Standalone;
+		SaveArgs.Error = GError;
+		SaveArgs.SaveFlags = SAVE_NoError;
+
+		TArray<FSavePackageResultStruct> Results;
+		UPackage::SaveConcurrent(SaveInfos, SaveArgs, Results);
+
+		for (int32 Index = 0; Index < Saves.Num(); ++Index)
+		{
+			if (!Results.IsValidIndex(Index) || !Results[Index].IsSuccessful())
+			{
+				UE_LOG(LogCharacterCreation, Warning, TEXT("Failed to save package: %s"), *Saves[Index].Package->GetName());
+				++NumFailed;
+			}
+		}
+	}
+	else
+	{
+		for (const FPendingSave& Save : Saves)
+		{
+			if (!SaveSinglePackage(Save))
+			{
+				++NumFailed;
+			}
+		}
+	}
+
+	const double ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+	TotalSaveSeconds += ElapsedSeconds;
+
+	// Size on disk of the batch, for the pipeline report
+	int64 SavedBytes = 0;
+	for (const FPendingSave& Save : Saves)
+	{
+		SavedBytes += FMath::Max<int64>(IFileManager::Get().FileSize(*Save.Filename), 0);
+	}
+	FSpritePipelineProfiler::Get().AddStageBytes(ESpritePipelineStage::Save, SavedBytes);
+
+	UE_LOG(LogCharacterCreation, Verbose, TEXT("Save batch: %d packages (%d failed) in %.2f ms [%s]"),
+		Saves.Num(), NumFailed, ElapsedSeconds * 1000.0, bConcurrent && Saves.Num() > 1 ? TEXT("concurrent") : TEXT("sequential"));
+
+	return NumFailed == 0;
+}
+
+bool FSpritePackageSaveQueue::SaveSinglePackage(const FPendingSave& Save)
+{
+	FSavePackageArgs SaveArgs;
+	SaveArgs.TopLevelFlags = EObjectFlags::RF_Public | EObjectFlags::RF_Standalone;
+	SaveArgs.Error = GError;
+	SaveArgs.SaveFlags = SAVE_NoError;
+	bool bSaved = UPackage::SavePackage(Save.Package, Save.Asset, *Save.Filename, SaveArgs);
+
+	if (bSaved)
+	{
+		UE_LOG(LogCharacterCreation, Verbose, TEXT("Saved package to disk: %s"), *Save.Package->GetName());
+	}
+	else
+	{
+		UE_LOG(LogCharacterCreation, Warning, TEXT("Failed to save package: %s"), *Save.Package->GetName());
+	}
+
+	return bSaved;
+}
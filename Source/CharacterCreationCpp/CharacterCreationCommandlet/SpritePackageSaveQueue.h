@@ -0,0 +1,88 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UPackage;
+
+/**
+ * Collects dirty asset packages produced by the sprite pipeline and writes them in one batch.
+ * Outside of an open batch, Enqueue() saves immediately so standalone callers keep their
+ * previous save-on-create behaviour.
+ */
+class CHARACTERCREATIONCPP_API FSpritePackageSaveQueue
+{
+public:
+	// Returns false only when an immediate (non-batched) save fails
+	bool Enqueue(UPackage* Package, UObject* Asset);
+
+	// Batches nest; packages are written when the outermost batch ends
+	void BeginBatch();
+	bool EndBatch(bool bConcurrent);
+
+	// Closes a batch without writing anything, so a half-created sheet never replaces the previous
+	// build on disk. Discarding an inner batch drops the whole outer batch when it ends.
+	void DiscardBatch();
+
+	bool IsBatching() const { return BatchDepth > 0; }
+	int32 NumPending() const { return PendingSaves.Num(); }
+
+	// Wall-clock time spent writing packages since construction
+	double GetTotalSaveSeconds() const { return TotalSaveSeconds; }
+
+private:
+	struct FPendingSave
+	{
+		UPackage* Package = nullptr;
+		UObject* Asset = nullptr;
+		FString Filename;
+	};
+
+	bool SavePackages(TArray<FPendingSave>& Saves, bool bConcurrent);
+	void DropPendingSaves();
+	static bool SaveSinglePackage(const FPendingSave& Save);
+
+	// Queued assets are RF_Standalone, so they survive GC until the batch is flushed
+	TArray<FPendingSave> PendingSaves;
+	int32 BatchDepth = 0;
+	bool bDiscardBatch = false;
+	double TotalSaveSeconds = 0.0;
+};
+
+/** RAII helper that opens a save batch and flushes it when the scope ends. */
+class FScopedSpritePackageSaveBatch
+{
+public:
+	FScopedSpritePackageSaveBatch(FSpritePackageSaveQueue& InQueue, bool bInConcurrent)
+		: Queue(InQueue)
+		, bConcurrent(bInConcurrent)
+	{
+		Queue.BeginBatch();
+	}
+
+	~FScopedSpritePackageSaveBatch()
+	{
+		if (!bFlushed)
+		{
+			Queue.EndBatch(bConcurrent);
+		}
+	}
+
+	// Flush early to observe the result; the destructor then does nothing
+	bool Flush()
+	{
+		bFlushed = true;
+		return Queue.EndBatch(bConcurrent);
+	}
+
+	// End the batch without saving what was queued in it
+	void Discard()
+	{
+		bFlushed = true;
+		Queue.DiscardBatch();
+	}
+
+private:
+	FSpritePackageSaveQueue& Queue;
+	bool bConcurrent;
+	bool bFlushed = false;
+};
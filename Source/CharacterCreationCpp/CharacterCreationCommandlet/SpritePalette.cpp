@@ -0,0 +1,104 @@
+#include "SpritePalette.h"
+
+const FName FSpritePalette::ParameterName(TEXT("Palette"));
+const TCHAR* FSpritePalette::MaterialPath = TEXT("/Game/Materials/M_PaletteSwap");
+
+FString FSpritePalette::GetPaletteTexturePath(const FString& VariantName)
+{
+	return FString::Printf(TEXT("/Game/Palettes/T_Palette_%s"), *VariantName);
+}
+
+FString FSpritePalette::GetIndexedSheetName(const FString& BaseSheetName)
+{
+	return BaseSheetName + TEXT("_Indexed");
+}
+
+uint32 FSpritePalette::PackColor(const uint8* Pixel)
+{
+	// Alpha stays in the encoded sheet, so only color identifies a palette entry
+	return uint32(Pixel[0]) | (uint32(Pixel[1]) << 8) | (uint32(Pixel[2]) << 16);
+}
+
+bool FSpritePalette::BuildFromImage(const uint8* Pixels, int64 NumPixels)
+{
+	Colors.Reset();
+	IndexByColor.Reset();
+
+	for (int64 PixelIndex = 0; PixelIndex < NumPixels; PixelIndex++)
+	{
+		const uint8* Pixel = Pixels + PixelIndex * 4;
+		if (Pixel[3] == 0)
+		{
+			continue;
+		}
+
+		const uint32 Key = PackColor(Pixel);
+		if (IndexByColor.Contains(Key))
+		{
+			continue;
+		}
+
+		if (Colors.Num() == MaxColors)
+		{
+			return false;
+		}
+
+		IndexByColor.Add(Key, uint8(Colors.Num()));
+		Colors.Add(FColor(Pixel[2], Pixel[1], Pixel[0], 255));
+	}
+
+	return true;
+}
+
+bool FSpritePalette::BuildVariantLUT(const uint8* BasePixels, const uint8* VariantPixels, int64 NumPixels,
+	TArray<FColor>& OutLUT, FString& OutError) const
+{
+	OutLUT.Init(FColor(0, 0, 0, 0), Colors.Num());
+	TBitArray<> Assigned(false, Colors.Num());
+
+	for (int64 PixelIndex = 0; PixelIndex < NumPixels; PixelIndex++)
+	{
+		const uint8* BasePixel = BasePixels + PixelIndex * 4;
+		const uint8* VariantPixel = VariantPixels + PixelIndex * 4;
+
+		if (BasePixel[3] != VariantPixel[3])
+		{
+			OutError = FString::Printf(TEXT("alpha differs at pixel %lld"), PixelIndex);
+			return false;
+		}
+
+		if (BasePixel[3] == 0)
+		{
+			continue;
+		}
+
+		const uint8 PaletteIndex = IndexByColor.FindChecked(PackColor(BasePixel));
+		const FColor VariantColor(VariantPixel[2], VariantPixel[1], VariantPixel[0], 255);
+
+		if (!Assigned[PaletteIndex])
+		{
+			Assigned[PaletteIndex] = true;
+			OutLUT[PaletteIndex] = VariantColor;
+		}
+		else if (OutLUT[PaletteIndex] != VariantColor)
+		{
+			OutError = FString::Printf(TEXT("base color %s maps to both %s and %s"),
+				*Colors[PaletteIndex].ToHex(), *OutLUT[PaletteIndex].ToHex(), *VariantColor.ToHex());
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void FSpritePalette::EncodeIndices(uint8* Pixels, int64 NumPixels) const
+{
+	for (int64 PixelIndex = 0; PixelIndex < NumPixels; PixelIndex++)
+	{
+		uint8* Pixel = Pixels + PixelIndex * 4;
+		const uint8 PaletteIndex = Pixel[3] != 0 ? IndexByColor.FindChecked(PackColor(Pixel)) : 0;
+		Pixel[0] = 0;
+		Pixel[1] = 0;
+		Pixel[2] = PaletteIndex;
+	}
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Color palette of a sprite sheet and the lookup tables of its recolored variants.
+ *
+ * A palette-swapped sheet is stored once with each visible pixel's palette index in the red
+ * channel and its alpha untouched. The palette material samples a MaxColors x 1 lookup texture
+ * with that index, so a new color variant only costs one lookup texture.
+ */
+class CHARACTERCREATIONCPP_API FSpritePalette
+{
+public:
+	static constexpr int32 MaxColors = 256;
+
+	// Shared between the generated assets and the characters that render them
+	static const FName ParameterName;
+	static const TCHAR* MaterialPath;
+	static FString GetPaletteTexturePath(const FString& VariantName);
+	static FString GetIndexedSheetName(const FString& BaseSheetName);
+
+	// Collects the distinct visible colors of a BGRA8 image in first-seen order.
+	// Fails if the image uses more than MaxColors colors.
+	bool BuildFromImage(const uint8* Pixels, int64 NumPixels);
+
+	// Derives the lookup table that maps this palette onto VariantPixels. Fails with a reason if the
+	// variant is not a pure recolor: alpha differs somewhere, or one base color becomes two colors.
+	// Must run before EncodeIndices, while BasePixels still holds colors.
+	bool BuildVariantLUT(const uint8* BasePixels, const uint8* VariantPixels, int64 NumPixels,
+		TArray<FColor>& OutLUT, FString& OutError) const;
+
+	// Rewrites a BGRA8 image in place: R holds the palette index, G and B are cleared, A is kept
+	void EncodeIndices(uint8* Pixels, int64 NumPixels) const;
+
+	const TArray<FColor>& GetColors() const { return Colors; }
+	int32 Num() const { return Colors.Num(); }
+
+private:
+	static uint32 PackColor(const uint8* Pixel);
+
+	TArray<FColor> Colors;
+	TMap<uint32, uint8> IndexByColor;
+};
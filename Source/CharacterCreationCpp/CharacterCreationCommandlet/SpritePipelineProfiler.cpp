@@ -0,0 +1,151 @@
+#include "SpritePipelineProfiler.h"
+#include "CharacterCreationLog.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+FSpritePipelineProfiler& FSpritePipelineProfiler::Get()
+{
+	static FSpritePipelineProfiler Profiler;
+	return Profiler;
+}
+
+const TCHAR* FSpritePipelineProfiler::GetStageName(ESpritePipelineStage Stage)
+{
+	switch (Stage)
+	{
+	case ESpritePipelineStage::FileRead:		return TEXT("FileRead");
+	case ESpritePipelineStage::Decode:			return TEXT("Decode");
+	case ESpritePipelineStage::Slice:			return TEXT("Slice");
+	case ESpritePipelineStage::SheetTexture:	return TEXT("SheetTexture");
+	case ESpritePipelineStage::SpriteTexture:	return TEXT("SpriteTexture");
+	case ESpritePipelineStage::SpriteBuild:		return TEXT("SpriteBuild");
+	case ESpritePipelineStage::PostEditChange:	return TEXT("PostEditChange");
+	case ESpritePipelineStage::Flipbooks:		return TEXT("Flipbooks");
+	case ESpritePipelineStage::Save:			return TEXT("Save");
+	default:									return TEXT("Unknown");
+	}
+}
+
+void FSpritePipelineProfiler::Reset()
+{
+	for (FStageTotals& Totals : Stages)
+	{
+		Totals.Cycles = 0;
+		Totals.Calls = 0;
+		Totals.Bytes = 0;
+	}
+
+	FScopeLock Lock(&SheetsLock);
+	Sheets.Reset();
+	RunStartSeconds = FPlatformTime::Seconds();
+}
+
+void FSpritePipelineProfiler::AddStageCycles(ESpritePipelineStage Stage, uint64 Cycles)
+{
+	FStageTotals& Totals = Stages[static_cast<int32>(Stage)];
+	Totals.Cycles.fetch_add(Cycles, std::memory_order_relaxed);
+	Totals.Calls.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FSpritePipelineProfiler::AddStageBytes(ESpritePipelineStage Stage, int64 Bytes)
+{
+	Stages[static_cast<int32>(Stage)].Bytes.fetch_add(Bytes, std::memory_order_relaxed);
+}
+
+void FSpritePipelineProfiler::AddSheet(const FSheetRecord& Sheet)
+{
+	FScopeLock Lock(&SheetsLock);
+	Sheets.Add(Sheet);
+}
+
+bool FSpritePipelineProfiler::WriteReport(const FString& ReportPath) const
+{
+	const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+
+	TSharedRef<FJsonObject> Root = FPerformanceReport::MakeRoot(1);
+	Root->SetNumberField(TEXT("TotalMs"), (FPlatformTime::Seconds() - RunStartSeconds) * 1000.0);
+	Root->SetNumberField(TEXT("PeakUsedPhysicalBytes"), static_cast<double>(MemoryStats.PeakUsedPhysical));
+	Root->SetNumberField(TEXT("UsedPhysicalBytes"), static_cast<double>(MemoryStats.UsedPhysical));
+
+	TSharedRef<FJsonObject> StagesObject = MakeShared<FJsonObject>();
+	for (int32 Index = 0; Index < static_cast<int32>(ESpritePipelineStage::Count); Index++)
+	{
+		const FStageTotals& Totals = Stages[Index];
+		TSharedRef<FJsonObject> StageObject = MakeShared<FJsonObject>();
+		StageObject->SetNumberField(TEXT("Ms"), FPlatformTime::ToMilliseconds64(Totals.Cycles.load()));
+		StageObject->SetNumberField(TEXT("Calls"), static_cast<double>(Totals.Calls.load()));
+		StageObject->SetNumberField(TEXT("Bytes"), static_cast<double>(Totals.Bytes.load()));
+		StagesObject->SetObjectField(GetStageName(static_cast<ESpritePipelineStage>(Index)), StageObject);
+	}
+	Root->SetObjectField(TEXT("Stages"), StagesObject);
+
+	TArray<TSharedPtr<FJsonValue>> SheetValues;
+	{
+		FScopeLock Lock(&SheetsLock);
+		for (const FSheetRecord& Sheet : Sheets)
+		{
+			TSharedRef<FJsonObject> SheetObject = MakeShared<FJsonObject>();
+			SheetObject->SetStringField(TEXT("Name"), Sheet.Name);
+			SheetObject->SetBoolField(TEXT("Success"), Sheet.bSuccess);
+			SheetObject->SetNumberField(TEXT("Sprites"), Sheet.Sprites);
+			SheetObject->SetNumberField(TEXT("Flipbooks"), Sheet.Flipbooks);
+			SheetObject->SetNumberField(TEXT("Packages"), Sheet.Packages);
+			SheetObject->SetNumberField(TEXT("TotalMs"), Sheet.TotalMs);
+			SheetObject->SetNumberField(TEXT("SaveMs"), Sheet.SaveMs);
+			SheetObject->SetNumberField(TEXT("UsedPhysicalBytes"), static_cast<double>(Sheet.UsedPhysicalBytes));
+			SheetValues.Add(MakeShared<FJsonValueObject>(SheetObject));
+		}
+	}
+	Root->SetArrayField(TEXT("Sheets"), SheetValues);
+
+	if (!FPerformanceReport::Write(Root, ReportPath))
+	{
+		UE_LOG(LogCharacterCreation, Error, TEXT("Failed to write pipeline report: %s"), *ReportPath);
+		return false;
+	}
+
+	UE_LOG(LogCharacterCreation, Log, TEXT("Wrote pipeline report for %d sheets: %s"), SheetValues.Num(), *ReportPath);
+	return true;
+}
+
+double FPerformanceReport::GetPercentile(TArray<double> Samples, double Percentile)
+{
+	if (Samples.Num() == 0)
+	{
+		return 0.0;
+	}
+
+	Samples.Sort();
+	const int32 Rank = FMath::CeilToInt32(Percentile / 100.0 * Samples.Num());
+	return Samples[FMath::Clamp(Rank - 1, 0, Samples.Num() - 1)];
+}
+
+TSharedRef<FJsonObject> FPerformanceReport::MakePercentiles(const TArray<double>& Samples, int32 UpperPercentile)
+{
+	TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+	Object->SetNumberField(TEXT("P50"), GetPercentile(Samples, 50.0));
+	Object->SetNumberField(FString::Printf(TEXT("P%d"), UpperPercentile), GetPercentile(Samples, UpperPercentile));
+	Object->SetNumberField(TEXT("Max"), GetPercentile(Samples, 100.0));
+	return Object;
+}
+
+TSharedRef<FJsonObject> FPerformanceReport::MakeRoot(int32 Version)
+{
+	TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetNumberField(TEXT("Version"), Version);
+	Root->SetStringField(TEXT("Date"), FDateTime::UtcNow().ToIso8601());
+	return Root;
+}
+
+bool FPerformanceReport::Write(const TSharedRef<FJsonObject>& Root, const FString& ReportPath)
+{
+	FString JsonText;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonText);
+	return FJsonSerializer::Serialize(Root, Writer) && FFileHelper::SaveStringToFile(JsonText, *ReportPath);
+}
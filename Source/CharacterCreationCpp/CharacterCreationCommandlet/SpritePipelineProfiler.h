@@ -0,0 +1,116 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformTime.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include <atomic>
+
+// Stages of USpriteSheetProcessor that are timed separately. Stages nest (PostEditChange runs inside
+// SpriteTexture and SpriteBuild), so their times are inclusive and do not add up to the run time.
+enum class ESpritePipelineStage : uint8
+{
+	FileRead,
+	Decode,
+	Slice,
+	SheetTexture,
+	SpriteTexture,
+	SpriteBuild,
+	PostEditChange,
+	Flipbooks,
+	Save,
+	Count
+};
+
+/**
+ * Per-run timings and byte counts of the sprite pipeline, for catching content build regressions.
+ *
+ * Stages are recorded through SPRITE_PIPELINE_SCOPE, which also emits an Unreal Insights CPU event,
+ * and may run on decode workers. UCharacterCreationCommandlet writes the totals with -report=<path>.
+ */
+class CHARACTERCREATIONCPP_API FSpritePipelineProfiler
+{
+public:
+	struct FSheetRecord
+	{
+		FString Name;
+		bool bSuccess = false;
+		int32 Sprites = 0;
+		int32 Flipbooks = 0;
+		int32 Packages = 0;
+		double TotalMs = 0.0;
+		double SaveMs = 0.0;
+		uint64 UsedPhysicalBytes = 0;
+	};
+
+	static FSpritePipelineProfiler& Get();
+	static const TCHAR* GetStageName(ESpritePipelineStage Stage);
+
+	// Clears everything and restarts the run clock
+	void Reset();
+
+	void AddStageCycles(ESpritePipelineStage Stage, uint64 Cycles);
+	void AddStageBytes(ESpritePipelineStage Stage, int64 Bytes);
+	void AddSheet(const FSheetRecord& Sheet);
+
+	// Running totals, for callers that measure a span of the run by taking differences
+	uint64 GetStageCycles(ESpritePipelineStage Stage) const { return Stages[static_cast<int32>(Stage)].Cycles.load(std::memory_order_relaxed); }
+	int64 GetStageBytes(ESpritePipelineStage Stage) const { return Stages[static_cast<int32>(Stage)].Bytes.load(std::memory_order_relaxed); }
+
+	bool WriteReport(const FString& ReportPath) const;
+
+private:
+	struct FStageTotals
+	{
+		std::atomic<uint64> Cycles{0};
+		std::atomic<int64> Calls{0};
+		std::atomic<int64> Bytes{0};
+	};
+
+	FStageTotals Stages[static_cast<int32>(ESpritePipelineStage::Count)];
+
+	mutable FCriticalSection SheetsLock;
+	TArray<FSheetRecord> Sheets;
+
+	double RunStartSeconds = FPlatformTime::Seconds();
+};
+
+// Percentiles and JSON plumbing shared by the pipeline report and the benchmark commandlets
+struct CHARACTERCREATIONCPP_API FPerformanceReport
+{
+	// Nearest-rank percentile (0-100) of Samples, 0 when there are none
+	static double GetPercentile(TArray<double> Samples, double Percentile);
+
+	// { "P50", "P<UpperPercentile>", "Max" } of Samples
+	static TSharedRef<FJsonObject> MakePercentiles(const TArray<double>& Samples, int32 UpperPercentile);
+
+	// Root object carrying the fields every report starts with
+	static TSharedRef<FJsonObject> MakeRoot(int32 Version);
+
+	// Serializes Root to ReportPath; the caller logs the outcome under its own category
+	static bool Write(const TSharedRef<FJsonObject>& Root, const FString& ReportPath);
+};
+
+// Adds the lifetime of the enclosing scope to one pipeline stage
+class FSpritePipelineScope
+{
+public:
+	explicit FSpritePipelineScope(ESpritePipelineStage InStage)
+		: Stage(InStage)
+		, StartCycles(FPlatformTime::Cycles64())
+	{
+	}
+
+	~FSpritePipelineScope()
+	{
+		FSpritePipelineProfiler::Get().AddStageCycles(Stage, FPlatformTime::Cycles64() - StartCycles);
+	}
+
+private:
+	ESpritePipelineStage Stage;
+	uint64 StartCycles;
+};
+
+#define SPRITE_PIPELINE_SCOPE(Stage) \
+	TRACE_CPUPROFILER_EVENT_SCOPE(SpritePipeline_##Stage); \
+	FSpritePipelineScope PREPROCESSOR_JOIN(SpritePipelineScope_, __LINE__)(ESpritePipelineStage::Stage)
@@ -0,0 +1,401 @@
+#include "SpritePixelBlit.h"
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+	#include <arm_neon.h>
+	#define SPRITE_BLIT_NEON 1
+	#define SPRITE_BLIT_SSE2 0
+#elif PLATFORM_ENABLE_VECTORINTRINSICS
+	#include <emmintrin.h>
+	#define SPRITE_BLIT_NEON 0
+	#define SPRITE_BLIT_SSE2 1
+#else
+	#define SPRITE_BLIT_NEON 0
+	#define SPRITE_BLIT_SSE2 0
+#endif
+
+namespace
+{
+	// Exact round(Value * Alpha / 255) for 8-bit inputs
+	FORCEINLINE uint8 MultiplyDiv255(uint32 Value, uint32 Alpha)
+	{
+		uint32 Product = Value * Alpha + 128;
+		return static_cast<uint8>((Product + (Product >> 8)) >> 8);
+	}
+
+	void ConvertRowRGBA8(const uint8* Src, uint8* Dst, int32 NumPixels)
+	{
+		int32 X = 0;
+
+#if SPRITE_BLIT_NEON
+		for (; X + 16 <= NumPixels; X += 16)
+		{
+			uint8x16x4_t Pixels = vld4q_u8(Src + X * 4);
+			uint8x16_t Red = Pixels.val[0];
+			Pixels.val[0] = Pixels.val[2];
+			Pixels.val[2] = Red;
+			vst4q_u8(Dst + X * 4, Pixels);
+		}
+#elif SPRITE_BLIT_SSE2
+		// Swap bytes 0 and 2 of every 32-bit pixel
+		const __m128i GreenAlphaMask = _mm_set1_epi32(0xFF00FF00);
+		const __m128i LowByteMask = _mm_set1_epi32(0x000000FF);
+		for (; X + 4 <= NumPixels; X += 4)
+		{
+			__m128i Pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Src + X * 4));
+			__m128i GreenAlpha = _mm_and_si128(Pixels, GreenAlphaMask);
+			__m128i RedToBlue = _mm_slli_epi32(_mm_and_si128(Pixels, LowByteMask), 16);
+			__m128i BlueToRed = _mm_and_si128(_mm_srli_epi32(Pixels, 16), LowByteMask);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(Dst + X * 4), _mm_or_si128(GreenAlpha, _mm_or_si128(RedToBlue, BlueToRed)));
+		}
+#endif
+
+		for (; X < NumPixels; ++X)
+		{
+			const uint8* S = Src + X * 4;
+			uint8* D = Dst + X * 4;
+			D[0] = S[2];
+			D[1] = S[1];
+			D[2] = S[0];
+			D[3] = S[3];
+		}
+	}
+
+	void ConvertRowG8(const uint8* Src, uint8* Dst, int32 NumPixels)
+	{
+		int32 X = 0;
+
+#if SPRITE_BLIT_NEON
+		const uint8x16_t Opaque = vdupq_n_u8(0xFF);
+		for (; X + 16 <= NumPixels; X += 16)
+		{
+			uint8x16_t Gray = vld1q_u8(Src + X);
+			uint8x16x4_t Pixels = { { Gray, Gray, Gray, Opaque } };
+			vst4q_u8(Dst + X * 4, Pixels);
+		}
+#elif SPRITE_BLIT_SSE2
+		const __m128i Opaque = _mm_set1_epi8(static_cast<char>(0xFF));
+		for (; X + 16 <= NumPixels; X += 16)
+		{
+			__m128i Gray = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Src + X));
+			__m128i GrayGrayLo = _mm_unpacklo_epi8(Gray, Gray);
+			__m128i GrayAlphaLo = _mm_unpacklo_epi8(Gray, Opaque);
+			__m128i GrayGrayHi = _mm_unpackhi_epi8(Gray, Gray);
+			__m128i GrayAlphaHi = _mm_unpackhi_epi8(Gray, Opaque);
+
+			__m128i* Out = reinterpret_cast<__m128i*>(Dst + X * 4);
+			_mm_storeu_si128(Out + 0, _mm_unpacklo_epi16(GrayGrayLo, GrayAlphaLo));
+			_mm_storeu_si128(Out + 1, _mm_unpackhi_epi16(GrayGrayLo, GrayAlphaLo));
+			_mm_storeu_si128(Out + 2, _mm_unpacklo_epi16(GrayGrayHi, GrayAlphaHi));
+			_mm_storeu_si128(Out + 3, _mm_unpackhi_epi16(GrayGrayHi, GrayAlphaHi));
+		}
+#endif
+
+		for (; X < NumPixels; ++X)
+		{
+			uint8* D = Dst + X * 4;
+			D[0] = D[1] = D[2] = Src[X];
+			D[3] = 0xFF;
+		}
+	}
+
+	// 16-bit channels are reduced to their high byte
+	void ConvertRowRGBA16(const uint8* Src, uint8* Dst, int32 NumPixels)
+	{
+		const uint16* Src16 = reinterpret_cast<const uint16*>(Src);
+		int32 X = 0;
+
+#if SPRITE_BLIT_NEON
+		for (; X + 8 <= NumPixels; X += 8)
+		{
+			uint16x8x4_t Wide = vld4q_u16(Src16 + X * 4);
+			uint8x8x4_t Narrow;
+			Narrow.val[0] = vshrn_n_u16(Wide.val[2], 8);
+			Narrow.val[1] = vshrn_n_u16(Wide.val[1], 8);
+			Narrow.val[2] = vshrn_n_u16(Wide.val[0], 8);
+			Narrow.val[3] = vshrn_n_u16(Wide.val[3], 8);
+			vst4_u8(Dst + X * 4, Narrow);
+		}
+#elif SPRITE_BLIT_SSE2
+		const __m128i GreenAlphaMask = _mm_set1_epi32(0xFF00FF00);
+		const __m128i LowByteMask = _mm_set1_epi32(0x000000FF);
+		for (; X + 4 <= NumPixels; X += 4)
+		{
+			__m128i Wide0 = _mm_srli_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(Src16 + X * 4)), 8);
+			__m128i Wide1 = _mm_srli_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(Src16 + X * 4 + 8)), 8);
+			__m128i Pixels = _mm_packus_epi16(Wide0, Wide1);
+
+			__m128i GreenAlpha = _mm_and_si128(Pixels, GreenAlphaMask);
+			__m128i RedToBlue = _mm_slli_epi32(_mm_and_si128(Pixels, LowByteMask), 16);
+			__m128i BlueToRed = _mm_and_si128(_mm_srli_epi32(Pixels, 16), LowByteMask);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(Dst + X * 4), _mm_or_si128(GreenAlpha, _mm_or_si128(RedToBlue, BlueToRed)));
+		}
+#endif
+
+		for (; X < NumPixels; ++X)
+		{
+			const uint16* S = Src16 + X * 4;
+			uint8* D = Dst + X * 4;
+			D[0] = static_cast<uint8>(S[2] >> 8);
+			D[1] = static_cast<uint8>(S[1] >> 8);
+			D[2] = static_cast<uint8>(S[0] >> 8);
+			D[3] = static_cast<uint8>(S[3] >> 8);
+		}
+	}
+
+	// Index of the first pixel in [Begin, End) whose alpha exceeds Threshold, or End
+	int32 FindFirstVisible(const uint8* Row, int32 Begin, int32 End, uint8 Threshold)
+	{
+		int32 X = Begin;
+
+#if SPRITE_BLIT_NEON
+		for (; X + 16 <= End; X += 16)
+		{
+			if (vmaxvq_u8(vld4q_u8(Row + X * 4).val[3]) > Threshold)
+			{
+				break;
+			}
+		}
+#elif SPRITE_BLIT_SSE2
+		const __m128i AlphaMask = _mm_set1_epi32(0xFF000000);
+		const __m128i AlphaThreshold = _mm_set1_epi32(uint32(Threshold) << 24);
+		const __m128i Zero = _mm_setzero_si128();
+		for (; X + 4 <= End; X += 4)
+		{
+			__m128i Alpha = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(Row + X * 4)), AlphaMask);
+			if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_subs_epu8(Alpha, AlphaThreshold), Zero)) != 0xFFFF)
+			{
+				break;
+			}
+		}
+#endif
+
+		// Pinpoints the pixel inside the chunk that stopped the vector loop, or handles the tail
+		for (; X < End; ++X)
+		{
+			if (Row[X * 4 + 3] > Threshold)
+			{
+				return X;
+			}
+		}
+		return End;
+	}
+
+	// Index of the last pixel in [Begin, End) whose alpha exceeds Threshold, or Begin - 1
+	int32 FindLastVisible(const uint8* Row, int32 Begin, int32 End, uint8 Threshold)
+	{
+		int32 X = End;
+
+#if SPRITE_BLIT_NEON
+		for (; X - 16 >= Begin; X -= 16)
+		{
+			if (vmaxvq_u8(vld4q_u8(Row + (X - 16) * 4).val[3]) > Threshold)
+			{
+				break;
+			}
+		}
+#elif SPRITE_BLIT_SSE2
+		const __m128i AlphaMask = _mm_set1_epi32(0xFF000000);
+		const __m128i AlphaThreshold = _mm_set1_epi32(uint32(Threshold) << 24);
+		const __m128i Zero = _mm_setzero_si128();
+		for (; X - 4 >= Begin; X -= 4)
+		{
+			__m128i Alpha = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(Row + (X - 4) * 4)), AlphaMask);
+			if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_subs_epu8(Alpha, AlphaThreshold), Zero)) != 0xFFFF)
+			{
+				break;
+			}
+		}
+#endif
+
+		for (; X > Begin; --X)
+		{
+			if (Row[(X - 1) * 4 + 3] > Threshold)
+			{
+				return X - 1;
+			}
+		}
+		return Begin - 1;
+	}
+
+	void PremultiplyRow(uint8* Row, int64 NumPixels)
+	{
+		int64 X = 0;
+
+#if SPRITE_BLIT_NEON
+		for (; X + 16 <= NumPixels; X += 16)
+		{
+			uint8x16x4_t Pixels = vld4q_u8(Row + X * 4);
+			const uint8x16_t Alpha = Pixels.val[3];
+			for (int32 Channel = 0; Channel < 3; ++Channel)
+			{
+				uint16x8_t Lo = vmull_u8(vget_low_u8(Pixels.val[Channel]), vget_low_u8(Alpha));
+				uint16x8_t Hi = vmull_u8(vget_high_u8(Pixels.val[Channel]), vget_high_u8(Alpha));
+				Pixels.val[Channel] = vcombine_u8(vrshrn_n_u16(vrsraq_n_u16(Lo, Lo, 8), 8), vrshrn_n_u16(vrsraq_n_u16(Hi, Hi, 8), 8));
+			}
+			vst4q_u8(Row + X * 4, Pixels);
+		}
+#elif SPRITE_BLIT_SSE2
+		// Alpha lanes multiply by 255 so they come out of the divide unchanged
+		const __m128i Zero = _mm_setzero_si128();
+		const __m128i ColorLanes = _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1);
+		const __m128i AlphaLane255 = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+		const __m128i Round = _mm_set1_epi16(128);
+
+		auto Premultiply8 = [&](__m128i Wide)
+		{
+			__m128i Alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(Wide, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+			Alpha = _mm_or_si128(_mm_and_si128(Alpha, ColorLanes), AlphaLane255);
+			__m128i Product = _mm_add_epi16(_mm_mullo_epi16(Wide, Alpha), Round);
+			return _mm_srli_epi16(_mm_add_epi16(Product, _mm_srli_epi16(Product, 8)), 8);
+		};
+
+		for (; X + 4 <= NumPixels; X += 4)
+		{
+			__m128i Pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Row + X * 4));
+			__m128i Lo = Premultiply8(_mm_unpacklo_epi8(Pixels, Zero));
+			__m128i Hi = Premultiply8(_mm_unpackhi_epi8(Pixels, Zero));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(Row + X * 4), _mm_packus_epi16(Lo, Hi));
+		}
+#endif
+
+		for (; X < NumPixels; ++X)
+		{
+			uint8* P = Row + X * 4;
+			const uint32 Alpha = P[3];
+			P[0] = MultiplyDiv255(P[0], Alpha);
+			P[1] = MultiplyDiv255(P[1], Alpha);
+			P[2] = MultiplyDiv255(P[2], Alpha);
+		}
+	}
+}
+
+int32 FSpritePixelBlit::GetBytesPerPixel(ESpritePixelLayout Layout)
+{
+	switch (Layout)
+	{
+	case ESpritePixelLayout::G8:
+		return 1;
+	case ESpritePixelLayout::RGBA16:
+		return 8;
+	case ESpritePixelLayout::BGRA8:
+	case ESpritePixelLayout::RGBA8:
+	default:
+		return 4;
+	}
+}
+
+bool FSpritePixelBlit::LayoutFromPixelFormat(EPixelFormat PixelFormat, ESpritePixelLayout& OutLayout)
+{
+	switch (PixelFormat)
+	{
+	case PF_B8G8R8A8:
+		OutLayout = ESpritePixelLayout::BGRA8;
+		return true;
+	case PF_R8G8B8A8:
+		OutLayout = ESpritePixelLayout::RGBA8;
+		return true;
+	case PF_G8:
+		OutLayout = ESpritePixelLayout::G8;
+		return true;
+	case PF_R16G16B16A16_UNORM:
+		OutLayout = ESpritePixelLayout::RGBA16;
+		return true;
+	default:
+		return false;
+	}
+}
+
+bool FSpritePixelBlit::LayoutFromSourceFormat(ETextureSourceFormat SourceFormat, ESpritePixelLayout& OutLayout)
+{
+	switch (SourceFormat)
+	{
+	case TSF_BGRA8:
+		OutLayout = ESpritePixelLayout::BGRA8;
+		return true;
+	case TSF_G8:
+		OutLayout = ESpritePixelLayout::G8;
+		return true;
+	case TSF_RGBA16:
+		OutLayout = ESpritePixelLayout::RGBA16;
+		return true;
+	default:
+		return false;
+	}
+}
+
+void FSpritePixelBlit::BlitRegionToBGRA8(const uint8* SourceData, int32 SourceWidth, ESpritePixelLayout SourceLayout,
+	int32 StartX, int32 StartY, int32 RegionWidth, int32 RegionHeight, uint8* DestData, bool bPremultiplyAlpha)
+{
+	const int32 SourceBytesPerPixel = GetBytesPerPixel(SourceLayout);
+	const int64 SourceStride = int64(SourceWidth) * SourceBytesPerPixel;
+	const int64 DestStride = int64(RegionWidth) * 4;
+
+	// Each row is converted and premultiplied while it is still in cache
+	for (int32 Y = 0; Y < RegionHeight; ++Y)
+	{
+		const uint8* SrcRow = SourceData + (StartY + Y) * SourceStride + int64(StartX) * SourceBytesPerPixel;
+		uint8* DstRow = DestData + Y * DestStride;
+
+		switch (SourceLayout)
+		{
+		case ESpritePixelLayout::BGRA8:
+			FMemory::Memcpy(DstRow, SrcRow, DestStride);
+			break;
+		case ESpritePixelLayout::RGBA8:
+			ConvertRowRGBA8(SrcRow, DstRow, RegionWidth);
+			break;
+		case ESpritePixelLayout::G8:
+			ConvertRowG8(SrcRow, DstRow, RegionWidth);
+			break;
+		case ESpritePixelLayout::RGBA16:
+			ConvertRowRGBA16(SrcRow, DstRow, RegionWidth);
+			break;
+		}
+
+		if (bPremultiplyAlpha)
+		{
+			PremultiplyRow(DstRow, RegionWidth);
+		}
+	}
+}
+
+void FSpritePixelBlit::PremultiplyAlphaBGRA8(uint8* Data, int64 NumPixels)
+{
+	PremultiplyRow(Data, NumPixels);
+}
+
+FIntRect FSpritePixelBlit::FindOpaqueBounds(const uint8* SourceData, int32 SourceWidth,
+	int32 StartX, int32 StartY, int32 RegionWidth, int32 RegionHeight, uint8 AlphaThreshold)
+{
+	const int64 SourceStride = int64(SourceWidth) * 4;
+	auto GetRow = [&](int32 Y) { return SourceData + (StartY + Y) * SourceStride + int64(StartX) * 4; };
+
+	int32 MinY = 0;
+	while (MinY < RegionHeight && FindFirstVisible(GetRow(MinY), 0, RegionWidth, AlphaThreshold) == RegionWidth)
+	{
+		++MinY;
+	}
+
+	if (MinY == RegionHeight)
+	{
+		return FIntRect();
+	}
+
+	int32 MaxY = RegionHeight - 1;
+	while (FindFirstVisible(GetRow(MaxY), 0, RegionWidth, AlphaThreshold) == RegionWidth)
+	{
+		--MaxY;
+	}
+
+	// Each row only has to look outside the columns already known to be visible
+	int32 MinX = RegionWidth;
+	int32 MaxX = -1;
+	for (int32 Y = MinY; Y <= MaxY; ++Y)
+	{
+		const uint8* Row = GetRow(Y);
+		MinX = FMath::Min(MinX, FindFirstVisible(Row, 0, MinX, AlphaThreshold));
+		MaxX = FMath::Max(MaxX, FindLastVisible(Row, MaxX + 1, RegionWidth, AlphaThreshold));
+	}
+
+	return FIntRect(MinX, MinY, MaxX + 1, MaxY + 1);
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PixelFormat.h"
+#include "Engine/Texture.h"
+
+/** Pixel layouts the sprite blitter can read. Output is always tightly packed BGRA8. */
+enum class ESpritePixelLayout : uint8
+{
+	BGRA8,
+	RGBA8,
+	G8,
+	RGBA16
+};
+
+/**
+ * Region copy with on-the-fly format conversion for sprite slicing.
+ * Rows are converted with SSE2 or NEON where available and a scalar loop otherwise.
+ */
+class CHARACTERCREATIONCPP_API FSpritePixelBlit
+{
+public:
+	static int32 GetBytesPerPixel(ESpritePixelLayout Layout);
+
+	// Return false for formats the blitter cannot convert
+	static bool LayoutFromPixelFormat(EPixelFormat PixelFormat, ESpritePixelLayout& OutLayout);
+	static bool LayoutFromSourceFormat(ETextureSourceFormat SourceFormat, ESpritePixelLayout& OutLayout);
+
+	// Copy a RegionWidth x RegionHeight block starting at (StartX, StartY) of a SourceWidth-wide image
+	// into DestData as BGRA8, optionally premultiplying color by alpha. The caller guarantees bounds.
+	static void BlitRegionToBGRA8(const uint8* SourceData, int32 SourceWidth, ESpritePixelLayout SourceLayout,
+		int32 StartX, int32 StartY, int32 RegionWidth, int32 RegionHeight, uint8* DestData, bool bPremultiplyAlpha);
+
+	static void PremultiplyAlphaBGRA8(uint8* Data, int64 NumPixels);
+
+	// Smallest rectangle, relative to the region, holding every pixel with alpha above AlphaThreshold.
+	// Works on any 4-byte layout with alpha last (BGRA8, RGBA8). Returns an empty rect if nothing is visible.
+	static FIntRect FindOpaqueBounds(const uint8* SourceData, int32 SourceWidth,
+		int32 StartX, int32 StartY, int32 RegionWidth, int32 RegionHeight, uint8 AlphaThreshold = 0);
+};
@@ -0,0 +1,141 @@
+#include "SpritePixelBlit.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace SpritePixelBlitTest
+{
+	// Alpha values where rounding and the alpha lane of the premultiply are easiest to get wrong
+	const uint8 EdgeAlphas[] = { 0, 1, 254, 255 };
+
+	// Covers every tail length of the 4, 8 and 16 pixel vector loops
+	constexpr int32 MaxRegionWidth = 37;
+	constexpr int32 RegionHeight = 3;
+	constexpr int32 StartX = 3;
+	constexpr int32 StartY = 1;
+	constexpr int32 SourceWidth = StartX + MaxRegionWidth + 5;
+	constexpr int32 SourceHeight = StartY + RegionHeight + 1;
+
+	// One pixel at a time, the conversion every vector path has to reproduce exactly
+	void ReferenceBlit(const uint8* Source, ESpritePixelLayout Layout, int32 RegionWidth, uint8* Dest, bool bPremultiplyAlpha)
+	{
+		const int32 BytesPerPixel = FSpritePixelBlit::GetBytesPerPixel(Layout);
+		for (int32 Y = 0; Y < RegionHeight; ++Y)
+		{
+			for (int32 X = 0; X < RegionWidth; ++X)
+			{
+				const uint8* S = Source + (int64(StartY + Y) * SourceWidth + StartX + X) * BytesPerPixel;
+				const uint16* S16 = reinterpret_cast<const uint16*>(S);
+				uint8* D = Dest + (int64(Y) * RegionWidth + X) * 4;
+
+				switch (Layout)
+				{
+				case ESpritePixelLayout::BGRA8:
+					D[0] = S[0];
+					D[1] = S[1];
+					D[2] = S[2];
+					D[3] = S[3];
+					break;
+				case ESpritePixelLayout::RGBA8:
+					D[0] = S[2];
+					D[1] = S[1];
+					D[2] = S[0];
+					D[3] = S[3];
+					break;
+				case ESpritePixelLayout::G8:
+					D[0] = D[1] = D[2] = S[0];
+					D[3] = 0xFF;
+					break;
+				case ESpritePixelLayout::RGBA16:
+					D[0] = static_cast<uint8>(S16[2] >> 8);
+					D[1] = static_cast<uint8>(S16[1] >> 8);
+					D[2] = static_cast<uint8>(S16[0] >> 8);
+					D[3] = static_cast<uint8>(S16[3] >> 8);
+					break;
+				}
+
+				if (bPremultiplyAlpha)
+				{
+					for (int32 Channel = 0; Channel < 3; ++Channel)
+					{
+						D[Channel] = static_cast<uint8>(FMath::RoundToInt(D[Channel] * D[3] / 255.0));
+					}
+				}
+			}
+		}
+	}
+
+	// Random colors, with every other pixel's alpha taken from EdgeAlphas
+	TArray<uint8> MakeSource(ESpritePixelLayout Layout, FRandomStream& Random)
+	{
+		const int32 BytesPerPixel = FSpritePixelBlit::GetBytesPerPixel(Layout);
+		TArray<uint8> Source;
+		Source.SetNumUninitialized(SourceWidth * SourceHeight * BytesPerPixel);
+		for (uint8& Byte : Source)
+		{
+			Byte = static_cast<uint8>(Random.RandRange(0, 255));
+		}
+
+		if (Layout == ESpritePixelLayout::G8)
+		{
+			return Source;
+		}
+
+		// The alpha channel is the last one; for 16-bit channels its high byte is what survives
+		const int32 AlphaByte = BytesPerPixel - 1;
+		for (int32 Pixel = 0; Pixel < SourceWidth * SourceHeight; Pixel += 2)
+		{
+			Source[Pixel * BytesPerPixel + AlphaByte] = EdgeAlphas[(Pixel / 2) % UE_ARRAY_COUNT(EdgeAlphas)];
+		}
+		return Source;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpritePixelBlitMatchesScalarTest, "CharacterCreation.SpritePixelBlit.MatchesScalar",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FSpritePixelBlitMatchesScalarTest::RunTest(const FString& Parameters)
+{
+	using namespace SpritePixelBlitTest;
+
+	const ESpritePixelLayout Layouts[] = { ESpritePixelLayout::BGRA8, ESpritePixelLayout::RGBA8, ESpritePixelLayout::G8, ESpritePixelLayout::RGBA16 };
+	const TCHAR* LayoutNames[] = { TEXT("BGRA8"), TEXT("RGBA8"), TEXT("G8"), TEXT("RGBA16") };
+
+	FRandomStream Random(0x5B17);
+	for (int32 LayoutIndex = 0; LayoutIndex < UE_ARRAY_COUNT(Layouts); ++LayoutIndex)
+	{
+		const ESpritePixelLayout Layout = Layouts[LayoutIndex];
+		const TArray<uint8> Source = MakeSource(Layout, Random);
+
+		for (int32 Premultiply = 0; Premultiply < 2; ++Premultiply)
+		{
+			for (int32 RegionWidth = 1; RegionWidth <= MaxRegionWidth; ++RegionWidth)
+			{
+				TArray<uint8> Expected;
+				TArray<uint8> Actual;
+				Expected.SetNumZeroed(RegionWidth * RegionHeight * 4);
+				Actual.SetNumZeroed(RegionWidth * RegionHeight * 4);
+
+				ReferenceBlit(Source.GetData(), Layout, RegionWidth, Expected.GetData(), Premultiply != 0);
+				FSpritePixelBlit::BlitRegionToBGRA8(Source.GetData(), SourceWidth, Layout, StartX, StartY,
+					RegionWidth, RegionHeight, Actual.GetData(), Premultiply != 0);
+
+				for (int32 Byte = 0; Byte < Expected.Num(); ++Byte)
+				{
+					if (Expected[Byte] != Actual[Byte])
+					{
+						AddError(FString::Printf(TEXT("%s%s, width %d: pixel %d channel %d is %d, expected %d"),
+							LayoutNames[LayoutIndex], Premultiply ? TEXT(" premultiplied") : TEXT(""), RegionWidth,
+							Byte / 4, Byte % 4, Actual[Byte], Expected[Byte]));
+						break;
+					}
+				}
+			}
+		}
+	}
+
+	return !HasAnyErrors();
+}
+
+#endif
@@ -0,0 +1,224 @@
+#include "SpriteSheetLayout.h"
+#include "SpriteSheetProcessor.h"
+#include "CharacterCreationLog.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/SecureHash.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+FCriticalSection FSpriteSheetLayoutCache::CacheLock;
+TMap<FString, FSpriteSheetLayoutCache::FCachedSidecar> FSpriteSheetLayoutCache::Sidecars;
+TMap<int32, TSharedPtr<const FSpriteSheetLayout>> FSpriteSheetLayoutCache::DefaultLayouts;
+
+FSpriteSheetLayout FSpriteSheetLayout::MakeDefault(int32 Rows)
+{
+	FSpriteSheetLayout Layout;
+	Layout.ContentHash = TEXT("Default");
+
+	// Warrior sheets: one EAnimationType per row, attacks play once
+	const UEnum* AnimationEnum = StaticEnum<EAnimationType>();
+	for (int32 Row = 0; Row < Rows; Row++)
+	{
+		FSpriteAnimationLayout& Animation = Layout.Animations.AddDefaulted_GetRef();
+		Animation.Row = Row;
+
+		// NumEnums() counts the generated _MAX entry
+		if (Row < AnimationEnum->NumEnums() - 1)
+		{
+			Animation.Name = AnimationEnum->GetNameStringByIndex(Row);
+			Animation.bLooping = Row < static_cast<int32>(EAnimationType::AttackSideways);
+		}
+		else
+		{
+			Animation.Name = FString::Printf(TEXT("Row%d"), Row);
+		}
+	}
+
+	return Layout;
+}
+
+bool FSpriteSheetLayout::Parse(const FString& JsonText, FSpriteSheetLayout& OutLayout, FString& OutError)
+{
+	TSharedPtr<FJsonObject> Root;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonText);
+	if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid())
+	{
+		OutError = TEXT("not valid JSON");
+		return false;
+	}
+
+	double DefaultFramesPerSecond = 12.0;
+	Root->TryGetNumberField(TEXT("FramesPerSecond"), DefaultFramesPerSecond);
+
+	const TArray<TSharedPtr<FJsonValue>>* AnimationValues = nullptr;
+	if (!Root->TryGetArrayField(TEXT("Animations"), AnimationValues) || AnimationValues->Num() == 0)
+	{
+		OutError = TEXT("missing or empty \"Animations\" array");
+		return false;
+	}
+
+	OutLayout.Animations.Reset();
+	for (int32 Index = 0; Index < AnimationValues->Num(); Index++)
+	{
+		const TSharedPtr<FJsonObject> AnimationObject = (*AnimationValues)[Index]->AsObject();
+		if (!AnimationObject.IsValid())
+		{
+			OutError = FString::Printf(TEXT("animation %d is not an object"), Index);
+			return false;
+		}
+
+		FSpriteAnimationLayout& Animation = OutLayout.Animations.AddDefaulted_GetRef();
+		if (!AnimationObject->TryGetStringField(TEXT("Name"), Animation.Name) || Animation.Name.IsEmpty()
+			|| !AnimationObject->TryGetNumberField(TEXT("Row"), Animation.Row))
+		{
+			OutError = FString::Printf(TEXT("animation %d needs a \"Name\" and a \"Row\""), Index);
+			return false;
+		}
+
+		AnimationObject->TryGetNumberField(TEXT("FirstFrame"), Animation.FirstFrame);
+		AnimationObject->TryGetNumberField(TEXT("NumFrames"), Animation.NumFrames);
+		AnimationObject->TryGetBoolField(TEXT("Loop"), Animation.bLooping);
+
+		const TArray<TSharedPtr<FJsonValue>>* FrameRunValues = nullptr;
+		if (AnimationObject->TryGetArrayField(TEXT("FrameRuns"), FrameRunValues))
+		{
+			for (const TSharedPtr<FJsonValue>& FrameRunValue : *FrameRunValues)
+			{
+				int32 FrameRun = 0;
+				if (!FrameRunValue->TryGetNumber(FrameRun))
+				{
+					OutError = FString::Printf(TEXT("%s has a non-numeric entry in \"FrameRuns\""), *Animation.Name);
+					return false;
+				}
+				Animation.FrameRuns.Add(FrameRun);
+			}
+		}
+
+		double FramesPerSecond = DefaultFramesPerSecond;
+		AnimationObject->TryGetNumberField(TEXT("FramesPerSecond"), FramesPerSecond);
+		Animation.FramesPerSecond = static_cast<float>(FramesPerSecond);
+	}
+
+	return true;
+}
+
+bool FSpriteSheetLayout::Validate(int32 Columns, int32 Rows, FString& OutError) const
+{
+	TSet<FString> Names;
+	for (const FSpriteAnimationLayout& Animation : Animations)
+	{
+		bool bDuplicate = false;
+		Names.Add(Animation.Name, &bDuplicate);
+		if (bDuplicate)
+		{
+			OutError = FString::Printf(TEXT("animation name %s is used twice"), *Animation.Name);
+			return false;
+		}
+
+		const int32 NumFrames = GetNumFrames(Animation, Columns);
+		if (Animation.Row < 0 || Animation.Row >= Rows || Animation.FirstFrame < 0
+			|| NumFrames <= 0 || Animation.FirstFrame + NumFrames > Columns)
+		{
+			OutError = FString::Printf(TEXT("%s (row %d, frames %d+%d) does not fit a %dx%d grid"),
+				*Animation.Name, Animation.Row, Animation.FirstFrame, NumFrames, Columns, Rows);
+			return false;
+		}
+
+		if (Animation.FrameRuns.Num() > 0 && Animation.FrameRuns.Num() != NumFrames)
+		{
+			OutError = FString::Printf(TEXT("%s has %d frame runs for %d frames"), *Animation.Name, Animation.FrameRuns.Num(), NumFrames);
+			return false;
+		}
+
+		for (int32 FrameRun : Animation.FrameRuns)
+		{
+			if (FrameRun < 1)
+			{
+				OutError = FString::Printf(TEXT("%s has a frame run below 1"), *Animation.Name);
+				return false;
+			}
+		}
+
+		if (Animation.FramesPerSecond <= 0.0f)
+		{
+			OutError = FString::Printf(TEXT("%s has a non-positive frame rate"), *Animation.Name);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+int32 FSpriteSheetLayout::GetNumFrames(const FSpriteAnimationLayout& Animation, int32 Columns) const
+{
+	return Animation.NumFrames == INDEX_NONE ? Columns - Animation.FirstFrame : Animation.NumFrames;
+}
+
+int32 FSpriteSheetLayout::GetFrameRun(const FSpriteAnimationLayout& Animation, int32 FrameIndex) const
+{
+	return Animation.FrameRuns.IsValidIndex(FrameIndex) ? Animation.FrameRuns[FrameIndex] : 1;
+}
+
+FString FSpriteSheetLayoutCache::GetSidecarPath(const FString& RawAssetPath)
+{
+	return FPaths::ChangeExtension(RawAssetPath, TEXT("layout.json"));
+}
+
+TSharedPtr<const FSpriteSheetLayout> FSpriteSheetLayoutCache::Resolve(const FString& RawAssetPath, int32 Rows)
+{
+	const FString SidecarPath = GetSidecarPath(RawAssetPath);
+
+	FCachedSidecar Cached;
+	{
+		FScopeLock Lock(&CacheLock);
+		if (const FCachedSidecar* Found = Sidecars.Find(SidecarPath))
+		{
+			Cached = *Found;
+		}
+		else
+		{
+			FString JsonText;
+			if (FFileHelper::LoadFileToString(JsonText, *SidecarPath))
+			{
+				TSharedPtr<FSpriteSheetLayout> Layout = MakeShared<FSpriteSheetLayout>();
+				FString Error;
+				if (FSpriteSheetLayout::Parse(JsonText, *Layout, Error))
+				{
+					Layout->SourcePath = SidecarPath;
+					Layout->ContentHash = FMD5::HashAnsiString(*JsonText);
+					Cached.Layout = Layout;
+					UE_LOG(LogCharacterCreation, Log, TEXT("Loaded sheet layout %s (%d animations)"), *SidecarPath, Layout->Animations.Num());
+				}
+				else
+				{
+					Cached.bBroken = true;
+					UE_LOG(LogCharacterCreation, Error, TEXT("Invalid sheet layout %s: %s"), *SidecarPath, *Error);
+				}
+			}
+
+			Sidecars.Add(SidecarPath, Cached);
+		}
+	}
+
+	if (Cached.bBroken)
+	{
+		return nullptr;
+	}
+
+	if (Cached.Layout.IsValid())
+	{
+		return Cached.Layout;
+	}
+
+	FScopeLock Lock(&CacheLock);
+	TSharedPtr<const FSpriteSheetLayout>& DefaultLayout = DefaultLayouts.FindOrAdd(Rows);
+	if (!DefaultLayout.IsValid())
+	{
+		DefaultLayout = MakeShared<const FSpriteSheetLayout>(FSpriteSheetLayout::MakeDefault(Rows));
+	}
+	return DefaultLayout;
+}
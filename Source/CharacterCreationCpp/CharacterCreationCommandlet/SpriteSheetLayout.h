@@ -0,0 +1,80 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+/** One flipbook cut from a sprite sheet: a run of cells in one grid row. */
+struct FSpriteAnimationLayout
+{
+	FString Name;
+	int32 Row = 0;
+	int32 FirstFrame = 0;
+
+	// INDEX_NONE runs to the end of the row
+	int32 NumFrames = INDEX_NONE;
+
+	float FramesPerSecond = 12.0f;
+
+	// Saved on the sheet's UWarriorAnimationSet, which warriors and crowds play from
+	bool bLooping = true;
+
+	// Optional hold per frame, in frames at FramesPerSecond; empty means every frame shows once
+	TArray<int32> FrameRuns;
+};
+
+/**
+ * Which animations a sprite sheet holds and where. Read from an optional JSON sidecar next to the
+ * PNG (RawAssets/<Sheet>.layout.json); sheets without one use the warrior layout, one
+ * EAnimationType per row.
+ *
+ *   { "FramesPerSecond": 12,
+ *     "Animations": [ { "Name": "Idle", "Row": 0, "FirstFrame": 0, "NumFrames": 6, "FramesPerSecond": 8, "Loop": true,
+ *                       "FrameRuns": [ 2, 1, 1, 1, 1, 3 ] } ] }
+ */
+struct CHARACTERCREATIONCPP_API FSpriteSheetLayout
+{
+	TArray<FSpriteAnimationLayout> Animations;
+
+	// Sidecar the layout came from, empty for the default layout
+	FString SourcePath;
+
+	// MD5 of the sidecar text, or "Default"; part of the incremental manifest settings
+	FString ContentHash;
+
+	static FSpriteSheetLayout MakeDefault(int32 Rows);
+	static bool Parse(const FString& JsonText, FSpriteSheetLayout& OutLayout, FString& OutError);
+
+	// Every animation must name at least one cell inside the Columns x Rows grid
+	bool Validate(int32 Columns, int32 Rows, FString& OutError) const;
+
+	int32 GetNumFrames(const FSpriteAnimationLayout& Animation, int32 Columns) const;
+	int32 GetFrameRun(const FSpriteAnimationLayout& Animation, int32 FrameIndex) const;
+};
+
+/**
+ * Process-wide cache of parsed sidecars, so a layout is read once however many times its sheet is
+ * decoded, hashed or rebuilt in a run. Safe to use from decode worker threads.
+ */
+class CHARACTERCREATIONCPP_API FSpriteSheetLayoutCache
+{
+public:
+	static FString GetSidecarPath(const FString& RawAssetPath);
+
+	// The sidecar layout for a sheet, or the default layout for Rows rows if there is none.
+	// Returns null if a sidecar exists but cannot be parsed; guessing would mislabel every flipbook.
+	static TSharedPtr<const FSpriteSheetLayout> Resolve(const FString& RawAssetPath, int32 Rows);
+
+private:
+	// Layout is null when the sheet has no sidecar; either way the disk is only asked once
+	struct FCachedSidecar
+	{
+		TSharedPtr<const FSpriteSheetLayout> Layout;
+		bool bBroken = false;
+	};
+
+	static FCriticalSection CacheLock;
+	static TMap<FString, FCachedSidecar> Sidecars;
+
+	// Sheets without a sidecar share one default layout per row count
+	static TMap<int32, TSharedPtr<const FSpriteSheetLayout>> DefaultLayouts;
+};
@@ -0,0 +1,248 @@
+#include "SpriteSheetManifest.h"
+#include "SpriteSheetProcessor.h"
+#include "SpriteSheetLayout.h"
+#include "CharacterCreationLog.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+FString FSpriteSheetManifest::GetDefaultManifestPath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("CharacterCreation") / TEXT("SpriteSheetManifest.json");
+}
+
+FString FSpriteSheetManifest::HashSourceFile(const FString& FilePath)
+{
+	FMD5Hash Hash = FMD5Hash::HashFile(*FilePath);
+	return Hash.IsValid() ? LexToString(Hash) : FString();
+}
+
+FString FSpriteSheetManifest::HashSourceBytes(const TArray<uint8>& FileData)
+{
+	FMD5 Md5;
+	Md5.Update(FileData.GetData(), FileData.Num());
+
+	FMD5Hash Hash;
+	Hash.Set(Md5);
+	return LexToString(Hash);
+}
+
+FString FSpriteSheetManifest::HashSettings(const FString& TextureName, const FSpriteSheetInfo& SpriteInfo)
+{
+	const FString RawAssetPath = FPaths::ProjectDir() + TEXT("RawAssets/") + TextureName + TEXT(".png");
+	TSharedPtr<const FSpriteSheetLayout> Layout = FSpriteSheetLayoutCache::Resolve(RawAssetPath, SpriteInfo.Rows);
+
+	FString Settings = FString::Printf(TEXT("Columns=%d;Rows=%d;Source=%s;Dest=%s;Atlas=%d;Premultiply=%d;Trim=%d;Share=%d;Layout=%s"),
+		SpriteInfo.Columns, SpriteInfo.Rows, *SpriteInfo.SourceTexturePath, *SpriteInfo.DestinationPath,
+		SpriteInfo.bUseSheetAtlas ? 1 : 0, SpriteInfo.bPremultiplyAlpha ? 1 : 0, SpriteInfo.bTrimFrames ? 1 : 0,
+		SpriteInfo.bShareDuplicateFrames ? 1 : 0, Layout.IsValid() ? *Layout->ContentHash : TEXT("Broken"));
+	return FMD5::HashAnsiString(*Settings);
+}
+
+FString FSpriteSheetManifest::HashPaletteGroup(const FString& BaseTextureName, const TArray<FString>& VariantTextureNames, const FSpriteSheetInfo& SpriteInfo)
+{
+	const FString RawAssetsDir = FPaths::ProjectDir() + TEXT("RawAssets/");
+
+	// The index sheet is cut by the base's sidecar, not by one of its own
+	TSharedPtr<const FSpriteSheetLayout> Layout = FSpriteSheetLayoutCache::Resolve(RawAssetsDir + BaseTextureName + TEXT(".png"), SpriteInfo.Rows);
+	FString Group = FString::Printf(TEXT("Layout=%s"), Layout.IsValid() ? *Layout->ContentHash : TEXT("Broken"));
+
+	TArray<FString> Members = VariantTextureNames;
+	Members.Sort();
+	Members.Insert(BaseTextureName, 0);
+	for (const FString& Member : Members)
+	{
+		const FString MemberHash = HashSourceFile(RawAssetsDir + Member + TEXT(".png"));
+		if (MemberHash.IsEmpty())
+		{
+			return FString();
+		}
+		Group += FString::Printf(TEXT(";%s=%s"), *Member, *MemberHash);
+	}
+
+	return FMD5::HashAnsiString(*Group);
+}
+
+bool FSpriteSheetManifest::Load(const FString& InManifestPath)
+{
+	ManifestPath = InManifestPath;
+	Entries.Reset();
+
+	FString JsonText;
+	if (!FFileHelper::LoadFileToString(JsonText, *ManifestPath))
+	{
+		UE_LOG(LogCharacterCreation, Log, TEXT("No sprite sheet manifest at %s, starting fresh"), *ManifestPath);
+		return true;
+	}
+
+	TSharedPtr<FJsonObject> Root;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonText);
+	if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid())
+	{
+		UE_LOG(LogCharacterCreation, Warning, TEXT("Sprite sheet manifest is corrupt, ignoring it: %s"), *ManifestPath);
+		return false;
+	}
+
+	const TSharedPtr<FJsonObject>* SheetsObject = nullptr;
+	if (!Root->TryGetObjectField(TEXT("Sheets"), SheetsObject))
+	{
+		return true;
+	}
+
+	for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : (*SheetsObject)->Values)
+	{
+		const TSharedPtr<FJsonObject> EntryObject = Pair.Value->AsObject();
+		if (!EntryObject.IsValid())
+		{
+			continue;
+		}
+
+		FSpriteSheetManifestEntry& Entry = Entries.Add(Pair.Key);
+		Entry.SourceHash = EntryObject->GetStringField(TEXT("SourceHash"));
+		Entry.SettingsHash = EntryObject->GetStringField(TEXT("SettingsHash"));
+		Entry.ProcessorVersion = EntryObject->GetIntegerField(TEXT("ProcessorVersion"));
+		EntryObject->TryGetStringArrayField(TEXT("OutputPackages"), Entry.OutputPackages);
+		EntryObject->TryGetStringArrayField(TEXT("PaletteMembers"), Entry.PaletteMembers);
+
+		const TSharedPtr<FJsonObject>* DependenciesObject = nullptr;
+		if (EntryObject->TryGetObjectField(TEXT("Dependencies"), DependenciesObject))
+		{
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& Dependency : (*DependenciesObject)->Values)
+			{
+				Entry.Dependencies.Add(Dependency.Key, Dependency.Value->AsString());
+			}
+		}
+	}
+
+	UE_LOG(LogCharacterCreation, Log, TEXT("Loaded sprite sheet manifest with %d entries: %s"), Entries.Num(), *ManifestPath);
+	return true;
+}
+
+bool FSpriteSheetManifest::Save() const
+{
+	TSharedRef<FJsonObject> SheetsObject = MakeShared<FJsonObject>();
+	for (const TPair<FString, FSpriteSheetManifestEntry>& Pair : Entries)
+	{
+		TSharedRef<FJsonObject> EntryObject = MakeShared<FJsonObject>();
+		EntryObject->SetStringField(TEXT("SourceHash"), Pair.Value.SourceHash);
+		EntryObject->SetStringField(TEXT("SettingsHash"), Pair.Value.SettingsHash);
+		EntryObject->SetNumberField(TEXT("ProcessorVersion"), Pair.Value.ProcessorVersion);
+
+		TArray<TSharedPtr<FJsonValue>> Outputs;
+		for (const FString& PackageName : Pair.Value.OutputPackages)
+		{
+			Outputs.Add(MakeShared<FJsonValueString>(PackageName));
+		}
+		EntryObject->SetArrayField(TEXT("OutputPackages"), Outputs);
+
+		if (Pair.Value.PaletteMembers.Num() > 0)
+		{
+			TArray<TSharedPtr<FJsonValue>> Members;
+			for (const FString& Member : Pair.Value.PaletteMembers)
+			{
+				Members.Add(MakeShared<FJsonValueString>(Member));
+			}
+			EntryObject->SetArrayField(TEXT("PaletteMembers"), Members);
+		}
+
+		if (Pair.Value.Dependencies.Num() > 0)
+		{
+			TSharedRef<FJsonObject> DependenciesObject = MakeShared<FJsonObject>();
+			for (const TPair<FString, FString>& Dependency : Pair.Value.Dependencies)
+			{
+				DependenciesObject->SetStringField(Dependency.Key, Dependency.Value);
+			}
+			EntryObject->SetObjectField(TEXT("Dependencies"), DependenciesObject);
+		}
+
+		SheetsObject->SetObjectField(Pair.Key, EntryObject);
+	}
+
+	TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetObjectField(TEXT("Sheets"), SheetsObject);
+
+	FString JsonText;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonText);
+	if (!FJsonSerializer::Serialize(Root, Writer))
+	{
+		return false;
+	}
+
+	if (!FFileHelper::SaveStringToFile(JsonText, *ManifestPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	{
+		UE_LOG(LogCharacterCreation, Error, TEXT("Failed to write sprite sheet manifest: %s"), *ManifestPath);
+		return false;
+	}
+
+	return true;
+}
+
+const FSpriteSheetManifestEntry* FSpriteSheetManifest::FindReusableEntry(const FString& TextureName, const FSpriteSheetInfo& SpriteInfo) const
+{
+	const FSpriteSheetManifestEntry* Entry = Entries.Find(TextureName);
+	if (!Entry)
+	{
+		return nullptr;
+	}
+
+	if (Entry->ProcessorVersion != USpriteSheetProcessor::ProcessorVersion || Entry->SettingsHash != HashSettings(TextureName, SpriteInfo))
+	{
+		return nullptr;
+	}
+
+	// Outputs deleted or never saved mean the sheet has to be rebuilt
+	if (Entry->OutputPackages.Num() == 0)
+	{
+		return nullptr;
+	}
+
+	for (const FString& PackageName : Entry->OutputPackages)
+	{
+		if (!FPackageName::DoesPackageExist(PackageName))
+		{
+			UE_LOG(LogCharacterCreation, Log, TEXT("Output %s of %s is missing, rebuilding"), *PackageName, *TextureName);
+			return nullptr;
+		}
+	}
+
+	// Shared sprites belong to the sheet that created them, which rewrites them when it is rebuilt
+	for (const TPair<FString, FString>& Dependency : Entry->Dependencies)
+	{
+		if (GetSourceHash(Dependency.Key) != Dependency.Value)
+		{
+			UE_LOG(LogCharacterCreation, Log, TEXT("%s borrows frames from %s, which changed, rebuilding"), *TextureName, *Dependency.Key);
+			return nullptr;
+		}
+	}
+
+	return Entry;
+}
+
+void FSpriteSheetManifest::Record(const FString& TextureName, const FString& SourceHash, const FSpriteSheetInfo& SpriteInfo,
+	const TArray<FString>& OutputPackages, const TMap<FString, FString>& Dependencies, const TArray<FString>& PaletteMembers)
+{
+	FSpriteSheetManifestEntry& Entry = Entries.FindOrAdd(TextureName);
+	Entry.SourceHash = SourceHash;
+	Entry.SettingsHash = HashSettings(TextureName, SpriteInfo);
+	Entry.ProcessorVersion = USpriteSheetProcessor::ProcessorVersion;
+	Entry.OutputPackages = OutputPackages;
+	Entry.Dependencies = Dependencies;
+	Entry.PaletteMembers = PaletteMembers;
+}
+
+void FSpriteSheetManifest::Remove(const FString& TextureName)
+{
+	Entries.Remove(TextureName);
+}
+
+FString FSpriteSheetManifest::GetSourceHash(const FString& TextureName) const
+{
+	const FSpriteSheetManifestEntry* Entry = Entries.Find(TextureName);
+	return Entry ? Entry->SourceHash : FString();
+}
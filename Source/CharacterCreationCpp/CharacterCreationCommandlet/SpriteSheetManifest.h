@@ -0,0 +1,65 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FSpriteSheetInfo;
+
+/** What the last successful run produced for one sprite sheet. */
+struct FSpriteSheetManifestEntry
+{
+	FString SourceHash;
+	FString SettingsHash;
+	int32 ProcessorVersion = 0;
+	TArray<FString> OutputPackages;
+
+	// Sheets this one borrows shared sprites from, with their source hash at build time
+	TMap<FString, FString> Dependencies;
+
+	// Palette index sheets: the sheets stored as palettes of it, base first
+	TArray<FString> PaletteMembers;
+};
+
+/**
+ * Persistent record of processed sprite sheets, keyed by texture name.
+ * A sheet whose PNG, grid settings and processor version all match its entry,
+ * and whose outputs still exist, does not need to be processed again.
+ */
+class CHARACTERCREATIONCPP_API FSpriteSheetManifest
+{
+public:
+	static FString GetDefaultManifestPath();
+
+	// Pure functions of their inputs, safe to call from worker threads
+	static FString HashSourceFile(const FString& FilePath);
+	static FString HashSourceBytes(const TArray<uint8>& FileData);
+	// Covers the sheet's layout sidecar too, so editing it rebuilds the flipbooks
+	static FString HashSettings(const FString& TextureName, const FSpriteSheetInfo& SpriteInfo);
+	// Source hash of a palette index sheet: every candidate member PNG plus the base's layout sidecar.
+	// Empty if any of the PNGs cannot be read.
+	static FString HashPaletteGroup(const FString& BaseTextureName, const TArray<FString>& VariantTextureNames, const FSpriteSheetInfo& SpriteInfo);
+
+	// A missing manifest file is not an error; it just starts empty
+	bool Load(const FString& InManifestPath);
+	bool Save() const;
+
+	// Returns the entry only if it was produced with the same settings and processor version,
+	// every recorded output package is still on disk and no sheet it borrows sprites from has changed
+	const FSpriteSheetManifestEntry* FindReusableEntry(const FString& TextureName, const FSpriteSheetInfo& SpriteInfo) const;
+
+	void Record(const FString& TextureName, const FString& SourceHash, const FSpriteSheetInfo& SpriteInfo,
+		const TArray<FString>& OutputPackages, const TMap<FString, FString>& Dependencies,
+		const TArray<FString>& PaletteMembers = TArray<FString>());
+	void Remove(const FString& TextureName);
+
+	// Source hash of the last successful build of a sheet, or empty if it has none
+	FString GetSourceHash(const FString& TextureName) const;
+
+	// The recorded entry whether or not it is still reusable
+	const FSpriteSheetManifestEntry* Find(const FString& TextureName) const { return Entries.Find(TextureName); }
+
+	int32 Num() const { return Entries.Num(); }
+
+private:
+	FString ManifestPath;
+	TMap<FString, FSpriteSheetManifestEntry> Entries;
+};
@@ -18,10 +18,22 @@
 #include "IImageWrapperModule.h"
 #include "Modules/ModuleManager.h"
 #include "UObject/SavePackage.h"
+#include "Memory/SharedBuffer.h"
 #include "InputAction.h"
 #include "InputMappingContext.h"
 #include "EnhancedInputComponent.h"
 #include "InputModifiers.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/PlatformMemory.h"
+#include "SpriteSheetManifest.h"
+#include "PaperPropertyBindings.h"
+#include "SpritePipelineProfiler.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialExpressionAppendVector.h"
+#include "Materials/MaterialExpressionConstant.h"
+#include "Materials/MaterialExpressionMultiply.h"
+#include "Materials/MaterialExpressionTextureSampleParameter2D.h"
+#include "Materials/MaterialExpressionVertexColor.h"
 
 USpriteSheetProcessor::USpriteSheetProcessor()
 {
@@ -34,9 +46,89 @@ USpriteSheetProcessor::USpriteSheetProcessor()
 bool USpriteSheetProcessor::ProcessSpriteSheet(const FString& TextureName, const FSpriteSheetInfo& SpriteInfo)
 {
 	FString RawAssetPath = FPaths::ProjectDir() + TEXT("RawAssets/") + TextureName + TEXT(".png");
+
+	FDecodedSpriteSheet DecodedSheet;
+	DecodedSheet.TextureName = TextureName;
+	if (!DecodeSpriteSheet(RawAssetPath, SpriteInfo, DecodedSheet))
+	{
+		UE_LOG(LogCharacterCreation, Error, TEXT("Failed to import texture: %s"), *TextureName);
+		return false;
+	}
+
+	return ProcessDecodedSpriteSheet(TextureName, DecodedSheet, SpriteInfo);
+}
+
+bool USpriteSheetProcessor::ProcessDecodedSpriteSheet(const FString& TextureName, FDecodedSpriteSheet& DecodedSheet, const FSpriteSheetInfo& SpriteInfo)
+{
+	check(IsInGameThread());
+
+	if (!DecodedSheet.bValid)
+	{
+		UE_LOG(LogCharacterCreation, Error, TEXT("Failed to import texture: %s"), *TextureName);
+		return false;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	const double SaveSecondsBefore = SaveQueue.GetTotalSaveSeconds();
+
+	// Asset creation only queues packages; they are all written when the batch is flushed, and
+	// dropped if any asset failed so the previous build of the sheet stays intact
+	bool bCreated = false;
+	bool bSaved = false;
+	int32 NumPackages = 0;
+	{
+		FScopedSpritePackageSaveBatch SaveBatch(SaveQueue, bConcurrentSave);
+		bCreated = CreateSheetAssets(TextureName, DecodedSheet, SpriteInfo);
+		if (bCreated)
+		{
+			NumPackages = SaveQueue.NumPending();
+			bSaved = SaveBatch.Flush();
+		}
+		else
+		{
+			SaveBatch.Discard();
+		}
+	}
+
+	// The one line per sheet at Log; the per-asset detail behind it is Verbose
+	const double TotalMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	const double SaveMs = (SaveQueue.GetTotalSaveSeconds() - SaveSecondsBefore) * 1000.0;
+	UE_LOG(LogCharacterCreation, Log, TEXT("Sheet %s: %s, %dx%d grid, %d sprites, %d flipbooks, %d packages, %.2f ms (%.2f ms saving, %.0f%% I/O)"),
+		*TextureName, bCreated && bSaved ? TEXT("ok") : TEXT("FAILED"), DecodedSheet.Columns, DecodedSheet.Rows,
+		bCreated ? GeneratedSprites.Num() : 0, bCreated ? GeneratedFlipbooks.Num() : 0, NumPackages,
+		TotalMs, SaveMs, TotalMs > 0.0 ? SaveMs / TotalMs * 100.0 : 0.0);
+
+	FSpritePipelineProfiler::FSheetRecord SheetRecord;
+	SheetRecord.Name = TextureName;
+	SheetRecord.bSuccess = bCreated && bSaved;
+	SheetRecord.Sprites = bCreated ? GeneratedSprites.Num() : 0;
+	SheetRecord.Flipbooks = bCreated ? GeneratedFlipbooks.Num() : 0;
+	SheetRecord.Packages = NumPackages;
+	SheetRecord.TotalMs = TotalMs;
+	SheetRecord.SaveMs = SaveMs;
+	SheetRecord.UsedPhysicalBytes = FPlatformMemory::GetStats().UsedPhysical;
+	FSpritePipelineProfiler::Get().AddSheet(SheetRecord);
+
+	if (bCreated && !bSaved)
+	{
+		UE_LOG(LogCharacterCreation, Error, TEXT("Failed to save one or more packages for sprite sheet: %s"), *TextureName);
+	}
+
+	return bCreated && bSaved;
+}
+
+bool USpriteSheetProcessor::CreateSheetAssets(const FString& TextureName, FDecodedSpriteSheet& DecodedSheet, const FSpriteSheetInfo& SpriteInfo)
+{
+	// Checked before anything is created so a Paper2D layout change cannot leave half a sheet on disk
+	if (!FPaperPropertyBindings::Get())
+	{
+		UE_LOG(LogCharacterCreation, Error, TEXT("Paper2D properties could not be bound, not processing %s"), *TextureName);
+		return false;
+	}
+
 	FString DestinationPath = TEXT("/Game/") + TextureName;
 
-	UTexture2D* ImportedTexture = ImportTexture(RawAssetPath, DestinationPath);
+	UTexture2D* ImportedTexture = CreateSheetTexture(DecodedSheet, DestinationPath);
 	if (!ImportedTexture)
 	{
 		UE_LOG(LogCharacterCreation, Error, TEXT("Failed to import texture: %s"), *TextureName);
@@ -44,17 +136,24 @@ bool USpriteSheetProcessor::ProcessSpriteSheet(const FString& TextureName, const
 	}
 
 	// Log imported texture size (Paper2D settings already applied during creation)
-	UE_LOG(LogCharacterCreation, Warning, TEXT("Imported texture size: %dx%d"), ImportedTexture->GetSizeX(), ImportedTexture->GetSizeY());
+	UE_LOG(LogCharacterCreation, Verbose, TEXT("Imported texture size: %dx%d"), DecodedSheet.Width, DecodedSheet.Height);
 
-	// Now safely extract sprites from the properly configured texture
-	TArray<UPaperSprite*> ExtractedSprites = ExtractSprites(ImportedTexture, SpriteInfo);
+	// Atlas sprites point back into the sheet texture, so it has to be on disk as well
+	if (SpriteInfo.bUseSheetAtlas && !SaveSheetTexture(ImportedTexture))
+	{
+		UE_LOG(LogCharacterCreation, Error, TEXT("Failed to save sheet texture for atlas mode: %s"), *TextureName);
+		return false;
+	}
+
+	// Cells were already sliced by the decoder, so only asset creation happens here
+	TArray<UPaperSprite*> ExtractedSprites = ExtractSpritesFromDecoded(ImportedTexture, DecodedSheet, SpriteInfo);
 	if (ExtractedSprites.Num() == 0)
 	{
 		UE_LOG(LogCharacterCreation, Error, TEXT("Failed to extract sprites from texture: %s"), *TextureName);
 		return false;
 	}
 
-	TArray<UPaperFlipbook*> CreatedAnimations = CreateAnimations(ExtractedSprites, SpriteInfo, TextureName);
+	TArray<UPaperFlipbook*> CreatedAnimations = CreateLayoutAnimations(ExtractedSprites, DecodedSheet.CellHashes, DecodedSheet.Columns, DecodedSheet.Rows, *DecodedSheet.Layout, TextureName);
 	if (CreatedAnimations.Num() == 0)
 	{
 		UE_LOG(LogCharacterCreation, Error, TEXT("Failed to create animations from sprites"));
@@ -63,7 +162,205 @@ bool USpriteSheetProcessor::ProcessSpriteSheet(const FString& TextureName, const
 
 	GeneratedSprites = ExtractedSprites;
 	GeneratedFlipbooks = CreatedAnimations;
+	GeneratedAnimationSet = CreateAnimationSet(TextureName, *DecodedSheet.Layout, CreatedAnimations);
+
+	if (SpriteInfo.bTrimFrames)
+	{
+		LogTrimSavings(TextureName, DecodedSheet, SpriteInfo.bUseSheetAtlas);
+	}
+
+	bool bInputAssetsCreated = CreateInputAssetsIfMissing();
+
+	if (bInputAssetsCreated)
+	{
+		UE_LOG(LogCharacterCreation, Log, TEXT("Input system created: IA_Move, IA_Attack, and IMC_PlayerInput"));
+	}
+
+	return true;
+}
+
+bool USpriteSheetProcessor::ProcessPaletteVariants(const FString& BaseTextureName, const TArray<FString>& VariantTextureNames, const FSpriteSheetInfo& SpriteInfo, TArray<FString>& OutFallbackVariants)
+{
+#if WITH_EDITOR
+	check(IsInGameThread());
+	OutFallbackVariants.Reset();
+
+	const FString IndexedName = FSpritePalette::GetIndexedSheetName(BaseTextureName);
+
+	// The indexed sheet is cut into flipbooks the same way as the base sheet
+	const FString BaseRawAssetPath = FPaths::ProjectDir() + TEXT("RawAssets/") + BaseTextureName + TEXT(".png");
+	FDecodedSpriteSheet BaseSheet;
+	BaseSheet.TextureName = IndexedName;
+	BaseSheet.Layout = FSpriteSheetLayoutCache::Resolve(BaseRawAssetPath, SpriteInfo.Rows);
+
+	// Checked before the base and every variant are decoded, as for ordinary sheets
+	FString LayoutError;
+	if (BaseSheet.Layout.IsValid() && !BaseSheet.Layout->Validate(SpriteInfo.Columns, SpriteInfo.Rows, LayoutError))
+	{
+		UE_LOG(LogCharacterCreation, Error, TEXT("Sheet layout for %s does not match its %dx%d grid: %s"),
+			*BaseTextureName, SpriteInfo.Columns, SpriteInfo.Rows, *LayoutError);
+		OutFallbackVariants = VariantTextureNames;
+		return false;
+	}
+
+	if (!BaseSheet.Layout.IsValid() || !DecodeImageFile(BaseRawAssetPath, BaseSheet))
+	{
+		UE_LOG(LogCharacterCreation, Error, TEXT("Failed to decode palette base sheet: %s"), *BaseTextureName);
+		OutFallbackVariants = VariantTextureNames;
+		return false;
+	}
+
+	const int64 NumPixels = int64(BaseSheet.Width) * BaseSheet.Height;
+	FSpritePalette Palette;
+	if (!Palette.BuildFromImage(BaseSheet.Pixels.GetData(), NumPixels))
+	{
+		UE_LOG(LogCharacterCreation, Error, TEXT("%s uses more than %d colors and cannot be palette swapped"), *BaseTextureName, FSpritePalette::MaxColors);
+		OutFallbackVariants = VariantTextureNames;
+		return false;
+	}
+
+	// Every lookup table is derived while the base still holds colors; the base's own table is its palette
+	TArray<TPair<FString, TArray<FColor>>> PaletteTables;
+	PaletteTables.Emplace(BaseTextureName, Palette.GetColors());
+
+	for (const FString& VariantName : VariantTextureNames)
+	{
+		FDecodedSpriteSheet VariantSheet;
+		if (!DecodeImageFile(FPaths::ProjectDir() + TEXT("RawAssets/") + VariantName + TEXT(".png"), VariantSheet))
+		{
+			OutFallbackVariants.Add(VariantName);
+			continue;
+		}
+
+		if (VariantSheet.Width != BaseSheet.Width || VariantSheet.Height != BaseSheet.Height)
+		{
+			UE_LOG(LogCharacterCreation, Warning, TEXT("%s is %dx%d but %s is %dx%d, processing it as a full sheet"),
+				*VariantName, VariantSheet.Width, VariantSheet.Height, *BaseTextureName, BaseSheet.Width, BaseSheet.Height);
+			OutFallbackVariants.Add(VariantName);
+			continue;
+		}
+
+		TArray<FColor> LUT;
+		FString Reason;
+		if (!Palette.BuildVariantLUT(BaseSheet.Pixels.GetData(), VariantSheet.Pixels.GetData(), NumPixels, LUT, Reason))
+		{
+			UE_LOG(LogCharacterCreation, Warning, TEXT("%s is not a recolor of %s (%s), processing it as a full sheet"),
+				*VariantName, *BaseTextureName, *Reason);
+			OutFallbackVariants.Add(VariantName);
+			continue;
+		}
+
+		PaletteTables.Emplace(VariantName, MoveTemp(LUT));
+	}
+
+	Palette.EncodeIndices(BaseSheet.Pixels.GetData(), NumPixels);
+
+	// Premultiplying would scramble the indices; the palette material applies alpha itself
+	FSpriteSheetInfo IndexedInfo = SpriteInfo;
+	IndexedInfo.bPremultiplyAlpha = false;
+	if (!SliceSpriteSheet(IndexedInfo, BaseSheet))
+	{
+		return false;
+	}
+	BaseSheet.bValid = true;
+
+	bool bCreated = false;
+	bool bSaved = false;
+	{
+		// Index frames look nothing like color frames, so they are only shared within this sheet
+		TGuardValue<FSpriteFrameCache*> FrameCacheGuard(SharedFrameCache, nullptr);
+		TGuardValue<bool> IndexGuard(bEncodingPaletteIndices, true);
+		FScopedSpritePackageSaveBatch SaveBatch(SaveQueue, bConcurrentSave);
+
+		bCreated = CreateSheetAssets(IndexedName, BaseSheet, IndexedInfo);
+
+		UTexture2D* BasePalette = nullptr;
+		for (const TPair<FString, TArray<FColor>>& Table : PaletteTables)
+		{
+			UTexture2D* PaletteTexture = CreatePaletteTexture(Table.Key, Table.Value);
+			bCreated &= PaletteTexture != nullptr;
+			BasePalette = BasePalette ? BasePalette : PaletteTexture;
+		}
+
+		UTexture2D* DefaultSpriteTexture = GeneratedSprites.Num() > 0 && GeneratedSprites[0] ? GeneratedSprites[0]->GetSourceTexture() : nullptr;
+		bCreated = bCreated && CreatePaletteMaterialIfMissing(DefaultSpriteTexture, BasePalette);
+		if (bCreated)
+		{
+			bSaved = SaveBatch.Flush();
+		}
+		else
+		{
+			SaveBatch.Discard();
+		}
+	}
+
+	UE_LOG(LogCharacterCreation, Log, TEXT("Palette %s: %d colors, %d of %d variants stored as %d-byte palettes"),
+		*BaseTextureName, Palette.Num(), PaletteTables.Num() - 1, VariantTextureNames.Num(), FSpritePalette::MaxColors * 4);
+
+	return bCreated && bSaved;
+#else
+	UE_LOG(LogCharacterCreation, Error, TEXT("Palette variants are only available in editor builds"));
+	OutFallbackVariants = VariantTextureNames;
+	return false;
+#endif
+}
+
+void USpriteSheetProcessor::LogTrimSavings(const FString& TextureName, const FDecodedSpriteSheet& DecodedSheet, bool bUseSheetAtlas) const
+{
+	const int64 CellPixels = int64(DecodedSheet.CellWidth) * DecodedSheet.CellHeight;
+	const int64 UntrimmedPixels = CellPixels * DecodedSheet.CellBounds.Num();
+	int64 TrimmedPixels = 0;
+	for (const FIntRect& Bounds : DecodedSheet.CellBounds)
+	{
+		TrimmedPixels += Bounds.Area();
+	}
+
+	// Atlas sprites still share the full sheet texture, so only drawn area shrinks
+	const int64 BytesSaved = bUseSheetAtlas ? 0 : (UntrimmedPixels - TrimmedPixels) * 4;
+	UE_LOG(LogCharacterCreation, Log, TEXT("Trim %s: %lld -> %lld frame pixels (%.0f%% of cell area), %lld texture bytes saved"),
+		*TextureName, UntrimmedPixels, TrimmedPixels,
+		UntrimmedPixels > 0 ? double(TrimmedPixels) / double(UntrimmedPixels) * 100.0 : 0.0, BytesSaved);
+}
+
+TArray<FString> USpriteSheetProcessor::GetGeneratedPackageNames() const
+{
+	TArray<FString> PackageNames;
+	PackageNames.Reserve(GeneratedSprites.Num() * 2 + GeneratedFlipbooks.Num());
+
+	for (const UPaperSprite* Sprite : GeneratedSprites)
+	{
+		if (Sprite)
+		{
+			// Shared frames appear once per cell that uses them
+			PackageNames.AddUnique(Sprite->GetPackage()->GetName());
 
+			// The per-cell texture, or the sheet texture in atlas mode. A missing texture has to
+			// invalidate the sheet just like a missing sprite would.
+			if (const UTexture2D* SourceTexture = Sprite->GetSourceTexture())
+			{
+				PackageNames.AddUnique(SourceTexture->GetPackage()->GetName());
+			}
+		}
+	}
+
+	for (const UPaperFlipbook* Flipbook : GeneratedFlipbooks)
+	{
+		if (Flipbook)
+		{
+			PackageNames.Add(Flipbook->GetPackage()->GetName());
+		}
+	}
+
+	if (GeneratedAnimationSet)
+	{
+		PackageNames.Add(GeneratedAnimationSet->GetPackage()->GetName());
+	}
+
+	return PackageNames;
+}
+
+bool USpriteSheetProcessor::CreateInputAssetsIfMissing()
+{
 	// Check if input assets already exist
 	UInputAction* MoveAction = LoadObject<UInputAction>(nullptr, TEXT("/Game/Input/IA_Move"));
 	UInputAction* AttackAction = LoadObject<UInputAction>(nullptr, TEXT("/Game/Input/IA_Attack"));
@@ -74,91 +371,286 @@ bool USpriteSheetProcessor::ProcessSpriteSheet(const FString& TextureName, const
 	// Only create input assets if they don't exist
 	if (!MoveAction || !AttackAction || !MappingContext)
 	{
-		UE_LOG(LogCharacterCreation, Warning, TEXT("Input assets not found, creating new ones..."));
+		UE_LOG(LogCharacterCreation, Log, TEXT("Input assets not found, creating new ones"));
 		
 		// Create Input Actions if they don't exist
 		if (!MoveAction)
 		{
-			UE_LOG(LogCharacterCreation, Warning, TEXT("Creating Input Action: IA_Move..."));
+			UE_LOG(LogCharacterCreation, Verbose, TEXT("Creating Input Action: IA_Move"));
 			MoveAction = CreateInputAction(TEXT("IA_Move"), TEXT("/Game/Input/IA_Move"));
 		}
 		
 		if (!AttackAction)
 		{
-			UE_LOG(LogCharacterCreation, Warning, TEXT("Creating Input Action: IA_Attack..."));
+			UE_LOG(LogCharacterCreation, Verbose, TEXT("Creating Input Action: IA_Attack"));
 			AttackAction = CreateInputAction(TEXT("IA_Attack"), TEXT("/Game/Input/IA_Attack"));
 		}
 		
 		// Create Input Mapping Context if it doesn't exist
 		if (!MappingContext && MoveAction && AttackAction)
 		{
-			UE_LOG(LogCharacterCreation, Warning, TEXT("Creating Input Mapping Context: IMC_PlayerInput..."));
+			UE_LOG(LogCharacterCreation, Verbose, TEXT("Creating Input Mapping Context: IMC_PlayerInput"));
 			MappingContext = CreateInputMappingContext(TEXT("IMC_PlayerInput"), TEXT("/Game/Input/IMC_PlayerInput"), MoveAction, AttackAction);
 			bInputAssetsCreated = true;
 		}
 	}
 	else
 	{
-		UE_LOG(LogCharacterCreation, Warning, TEXT("Input assets already exist, skipping creation"));
+		UE_LOG(LogCharacterCreation, Verbose, TEXT("Input assets already exist, skipping creation"));
 	}
 
-	UE_LOG(LogCharacterCreation, Log, TEXT("Successfully processed sprite sheet: %s"), *TextureName);
-	UE_LOG(LogCharacterCreation, Log, TEXT("Generated %d sprites and %d animations"), ExtractedSprites.Num(), CreatedAnimations.Num());
-	
-	if (bInputAssetsCreated)
+	return bInputAssetsCreated;
+}
+
+void USpriteSheetProcessor::PreloadDecoderModules()
+{
+	check(IsInGameThread());
+	FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+}
+
+bool USpriteSheetProcessor::DecodeSpriteSheet(const FString& RawAssetPath, const FSpriteSheetInfo& SpriteInfo, FDecodedSpriteSheet& OutSheet)
+{
+	OutSheet.bValid = false;
+
+	// Checked before decoding so a bad sidecar costs no PNG work
+	OutSheet.Layout = FSpriteSheetLayoutCache::Resolve(RawAssetPath, SpriteInfo.Rows);
+	if (!OutSheet.Layout.IsValid())
+	{
+		return false;
+	}
+
+	FString LayoutError;
+	if (!OutSheet.Layout->Validate(SpriteInfo.Columns, SpriteInfo.Rows, LayoutError))
 	{
-		UE_LOG(LogCharacterCreation, Warning, TEXT("✓ Input system created: IA_Move, IA_Attack, and IMC_PlayerInput"));
+		UE_LOG(LogCharacterCreation, Error, TEXT("Sheet layout for %s does not match its %dx%d grid: %s"),
+			*FPaths::GetCleanFilename(RawAssetPath), SpriteInfo.Columns, SpriteInfo.Rows, *LayoutError);
+		return false;
+	}
+
+	if (!DecodeImageFile(RawAssetPath, OutSheet))
+	{
+		return false;
+	}
+
+	if (!SliceSpriteSheet(SpriteInfo, OutSheet))
+	{
+		return false;
 	}
 
+	OutSheet.bValid = true;
 	return true;
 }
 
-UTexture2D* USpriteSheetProcessor::ImportTexture(const FString& RawAssetPath, const FString& DestinationPath)
+bool USpriteSheetProcessor::DecodeImageFile(const FString& RawAssetPath, FDecodedSpriteSheet& OutSheet)
 {
-#if WITH_EDITOR
+	OutSheet.SourceFilePath = RawAssetPath;
+
 	if (!FPaths::FileExists(RawAssetPath))
 	{
 		UE_LOG(LogCharacterCreation, Error, TEXT("Source texture file does not exist: %s"), *RawAssetPath);
-		return nullptr;
+		return false;
 	}
 
 	TArray<uint8> RawFileData;
-	if (!FFileHelper::LoadFileToArray(RawFileData, *RawAssetPath))
 	{
-		UE_LOG(LogCharacterCreation, Error, TEXT("Failed to load texture file: %s"), *RawAssetPath);
-		return nullptr;
+		SPRITE_PIPELINE_SCOPE(FileRead);
+		if (!FFileHelper::LoadFileToArray(RawFileData, *RawAssetPath))
+		{
+			UE_LOG(LogCharacterCreation, Error, TEXT("Failed to load texture file: %s"), *RawAssetPath);
+			return false;
+		}
+		FSpritePipelineProfiler::Get().AddStageBytes(ESpritePipelineStage::FileRead, RawFileData.Num());
+	}
+
+	UE_LOG(LogCharacterCreation, Verbose, TEXT("Raw file data size: %d bytes"), RawFileData.Num());
+	OutSheet.SourceHash = FSpriteSheetManifest::HashSourceBytes(RawFileData);
+	const int64 CompressedBytes = RawFileData.Num();
+
+	// Worker threads must not load modules, so they rely on PreloadDecoderModules() having run
+	IImageWrapperModule* ImageWrapperModule = IsInGameThread()
+		? &FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"))
+		: FModuleManager::GetModulePtr<IImageWrapperModule>(FName("ImageWrapper"));
+	if (!ImageWrapperModule)
+	{
+		UE_LOG(LogCharacterCreation, Error, TEXT("ImageWrapper module not loaded - call PreloadDecoderModules() before decoding on worker threads"));
+		return false;
 	}
 
-	UE_LOG(LogCharacterCreation, Warning, TEXT("Raw file data size: %d bytes"), RawFileData.Num());
+	SPRITE_PIPELINE_SCOPE(Decode);
 
 	// Use IImageWrapper to decode PNG and get exact dimensions
-	IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
-	TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::PNG);
+	TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule->CreateImageWrapper(EImageFormat::PNG);
 	
 	if (!ImageWrapper.IsValid())
 	{
 		UE_LOG(LogCharacterCreation, Error, TEXT("Failed to create PNG image wrapper"));
-		return nullptr;
+		return false;
 	}
 
 	if (!ImageWrapper->SetCompressed(RawFileData.GetData(), RawFileData.Num()))
 	{
 		UE_LOG(LogCharacterCreation, Error, TEXT("Failed to set compressed data in image wrapper"));
-		return nullptr;
+		return false;
 	}
 
-	int32 Width = ImageWrapper->GetWidth();
-	int32 Height = ImageWrapper->GetHeight();
-	UE_LOG(LogCharacterCreation, Warning, TEXT("Decoded image dimensions: %dx%d"), Width, Height);
+	// The wrapper keeps its own copy of the compressed stream
+	RawFileData.Empty();
+
+	OutSheet.Width = ImageWrapper->GetWidth();
+	OutSheet.Height = ImageWrapper->GetHeight();
+	UE_LOG(LogCharacterCreation, Verbose, TEXT("Decoded image dimensions: %dx%d"), OutSheet.Width, OutSheet.Height);
 
-	// Extract raw RGBA pixel data
-	TArray<uint8> UncompressedRGBA;
-	if (!ImageWrapper->GetRaw(ERGBFormat::BGRA, 8, UncompressedRGBA))
+	// Extract raw BGRA pixel data. The 64-bit overload hands over the wrapper's decode buffer
+	// instead of copying it, and dropping the wrapper releases the compressed stream.
+	if (!ImageWrapper->GetRaw(ERGBFormat::BGRA, 8, OutSheet.Pixels))
 	{
 		UE_LOG(LogCharacterCreation, Error, TEXT("Failed to get raw pixel data from image"));
+		return false;
+	}
+	ImageWrapper.Reset();
+	FSpritePipelineProfiler::Get().AddStageBytes(ESpritePipelineStage::Decode, OutSheet.Pixels.Num());
+
+	UE_LOG(LogCharacterCreation, Verbose, TEXT("Decoded %s: %lld compressed bytes -> %lld pixel bytes"),
+		*FPaths::GetCleanFilename(RawAssetPath), CompressedBytes, OutSheet.Pixels.Num());
+
+	return true;
+}
+
+bool USpriteSheetProcessor::SliceSpriteSheet(const FSpriteSheetInfo& SpriteInfo, FDecodedSpriteSheet& InOutSheet)
+{
+	SPRITE_PIPELINE_SCOPE(Slice);
+
+	const int32 BytesPerPixel = 4;
+
+	if (SpriteInfo.Columns <= 0 || SpriteInfo.Rows <= 0)
+	{
+		UE_LOG(LogCharacterCreation, Error, TEXT("Invalid grid dimensions: %dx%d"), SpriteInfo.Columns, SpriteInfo.Rows);
+		return false;
+	}
+
+	InOutSheet.Columns = SpriteInfo.Columns;
+	InOutSheet.Rows = SpriteInfo.Rows;
+	InOutSheet.CellWidth = InOutSheet.Width / SpriteInfo.Columns;
+	InOutSheet.CellHeight = InOutSheet.Height / SpriteInfo.Rows;
+
+	if (InOutSheet.CellWidth <= 0 || InOutSheet.CellHeight <= 0)
+	{
+		UE_LOG(LogCharacterCreation, Error, TEXT("Texture %dx%d is too small for a %dx%d grid"), 
+			InOutSheet.Width, InOutSheet.Height, SpriteInfo.Columns, SpriteInfo.Rows);
+		return false;
+	}
+
+	if (InOutSheet.Pixels.Num() < int64(InOutSheet.Width) * InOutSheet.Height * BytesPerPixel)
+	{
+		UE_LOG(LogCharacterCreation, Error, TEXT("Decoded pixel buffer is smaller than %dx%d"), InOutSheet.Width, InOutSheet.Height);
+		return false;
+	}
+
+	// Bounds are found before premultiplying, which never changes alpha anyway
+	InOutSheet.CellBounds.SetNum(SpriteInfo.Rows * SpriteInfo.Columns);
+	for (int32 Row = 0; Row < SpriteInfo.Rows; Row++)
+	{
+		for (int32 Col = 0; Col < SpriteInfo.Columns; Col++)
+		{
+			FIntRect Bounds(0, 0, InOutSheet.CellWidth, InOutSheet.CellHeight);
+			if (SpriteInfo.bTrimFrames)
+			{
+				Bounds = FSpritePixelBlit::FindOpaqueBounds(InOutSheet.Pixels.GetData(), InOutSheet.Width,
+					Col * InOutSheet.CellWidth, Row * InOutSheet.CellHeight, InOutSheet.CellWidth, InOutSheet.CellHeight);
+
+				// Keep a single transparent pixel for empty cells so every frame still has a sprite
+				if (Bounds.Area() == 0)
+				{
+					Bounds = FIntRect(0, 0, 1, 1);
+				}
+			}
+			InOutSheet.CellBounds[Row * SpriteInfo.Columns + Col] = Bounds;
+		}
+	}
+
+	// Atlas sprites read straight from the sheet texture, so there is nothing to copy
+	if (SpriteInfo.bUseSheetAtlas)
+	{
+		InOutSheet.Cells.Reset();
+		if (SpriteInfo.bPremultiplyAlpha)
+		{
+			FSpritePixelBlit::PremultiplyAlphaBGRA8(InOutSheet.Pixels.GetData(), int64(InOutSheet.Width) * InOutSheet.Height);
+		}
+
+		InOutSheet.CellHashes.SetNum(SpriteInfo.Rows * SpriteInfo.Columns);
+		for (int32 CellIndex = 0; CellIndex < InOutSheet.CellHashes.Num(); CellIndex++)
+		{
+			const FIntRect& Bounds = InOutSheet.CellBounds[CellIndex];
+			InOutSheet.CellHashes[CellIndex] = FSpriteFrameCache::HashFrame(InOutSheet.Pixels.GetData(), InOutSheet.Width,
+				(CellIndex % SpriteInfo.Columns) * InOutSheet.CellWidth + Bounds.Min.X, (CellIndex / SpriteInfo.Columns) * InOutSheet.CellHeight + Bounds.Min.Y,
+				Bounds, FIntPoint(InOutSheet.CellWidth, InOutSheet.CellHeight));
+		}
+		return true;
+	}
+
+	const uint8* SourceData = InOutSheet.Pixels.GetData();
+
+	InOutSheet.Cells.SetNum(SpriteInfo.Rows * SpriteInfo.Columns);
+	for (int32 Row = 0; Row < SpriteInfo.Rows; Row++)
+	{
+		for (int32 Col = 0; Col < SpriteInfo.Columns; Col++)
+		{
+			const int32 CellIndex = Row * SpriteInfo.Columns + Col;
+			const FIntRect& Bounds = InOutSheet.CellBounds[CellIndex];
+
+			TArray<uint8>& Cell = InOutSheet.Cells[CellIndex];
+			Cell.SetNumUninitialized(Bounds.Area() * BytesPerPixel);
+
+			FSpritePixelBlit::BlitRegionToBGRA8(SourceData, InOutSheet.Width, ESpritePixelLayout::BGRA8,
+				Col * InOutSheet.CellWidth + Bounds.Min.X, Row * InOutSheet.CellHeight + Bounds.Min.Y, Bounds.Width(), Bounds.Height(),
+				Cell.GetData(), SpriteInfo.bPremultiplyAlpha);
+		}
+	}
+
+	// Hash after premultiplying so only frames that render identically match
+	InOutSheet.CellHashes.SetNum(InOutSheet.Cells.Num());
+	for (int32 CellIndex = 0; CellIndex < InOutSheet.Cells.Num(); CellIndex++)
+	{
+		const FIntRect& Bounds = InOutSheet.CellBounds[CellIndex];
+		InOutSheet.CellHashes[CellIndex] = FSpriteFrameCache::HashFrame(InOutSheet.Cells[CellIndex].GetData(), Bounds.Width(), 0, 0,
+			Bounds, FIntPoint(InOutSheet.CellWidth, InOutSheet.CellHeight));
+	}
+
+	return true;
+}
+
+UTexture2D* USpriteSheetProcessor::ImportTexture(const FString& RawAssetPath, const FString& DestinationPath)
+{
+#if WITH_EDITOR
+	FDecodedSpriteSheet DecodedSheet;
+	if (!DecodeImageFile(RawAssetPath, DecodedSheet))
+	{
 		return nullptr;
 	}
 
+	UTexture2D* NewTexture = CreateSheetTexture(DecodedSheet, DestinationPath);
+	if (NewTexture)
+	{
+		// Standalone callers may render the texture, so build platform data from the source now
+		NewTexture->UpdateResource();
+	}
+
+	return NewTexture;
+#else
+	UE_LOG(LogCharacterCreation, Error, TEXT("Import functionality is only available in editor builds"));
+	return nullptr;
+#endif
+}
+
+UTexture2D* USpriteSheetProcessor::CreateSheetTexture(FDecodedSpriteSheet& DecodedSheet, const FString& DestinationPath)
+{
+#if WITH_EDITOR
+	SPRITE_PIPELINE_SCOPE(SheetTexture);
+	FSpritePipelineProfiler::Get().AddStageBytes(ESpritePipelineStage::SheetTexture, DecodedSheet.Pixels.Num());
+
+	const int32 Width = DecodedSheet.Width;
+	const int32 Height = DecodedSheet.Height;
+
 	// Create package and texture manually
 	FString PackageName = DestinationPath;
 	FString AssetName = FPaths::GetBaseFilename(DestinationPath);
@@ -182,41 +674,26 @@ UTexture2D* USpriteSheetProcessor::ImportTexture(const FString& RawAssetPath, co
 	NewTexture->Filter = TF_Nearest;
 	NewTexture->MipGenSettings = TMGS_NoMipmaps;
 	NewTexture->CompressionSettings = TC_VectorDisplacementmap;
-	NewTexture->SRGB = true;
+	NewTexture->SRGB = !bEncodingPaletteIndices;
 	NewTexture->LODGroup = TEXTUREGROUP_World;
 	NewTexture->MaxTextureSize = 0;
 	NewTexture->PowerOfTwoMode = ETexturePowerOfTwoSetting::None;
 	NewTexture->NeverStream = true;
 
-	// Initialize texture with exact pixel data
-	TUniquePtr<FTexturePlatformData> PlatformData = MakeUnique<FTexturePlatformData>();
-	PlatformData->SizeX = Width;
-	PlatformData->SizeY = Height;
-	PlatformData->PixelFormat = PF_B8G8R8A8;
-
-	// Create mip map with exact size
-	FTexture2DMipMap* Mip = new FTexture2DMipMap();
-	PlatformData->Mips.Add(Mip);
-	NewTexture->SetPlatformData(PlatformData.Release());
-	Mip->SizeX = Width;
-	Mip->SizeY = Height;
-	
 	// Ensure thread safety for texture operations
 	check(IsInGameThread());
-	
-	// Copy pixel data
-	Mip->BulkData.Lock(LOCK_READ_WRITE);
-	uint8* TextureData = static_cast<uint8*>(Mip->BulkData.Realloc(UncompressedRGBA.Num()));
-	FMemory::Memcpy(TextureData, UncompressedRGBA.GetData(), UncompressedRGBA.Num());
-	Mip->BulkData.Unlock();
-
-	// Initialize source data
-	NewTexture->Source.Init(Width, Height, 1, 1, TSF_BGRA8, UncompressedRGBA.GetData());
+
+	// The source takes ownership of the decoded pixels, so the sheet exists in memory exactly once.
+	// Platform data is not filled by hand; PostEditChange/UpdateResource builds it from the source
+	// when the texture is saved or rendered, and sprite extraction reads the source directly.
+	NewTexture->Source.Init(Width, Height, 1, 1, TSF_BGRA8,
+		UE::Serialization::FEditorBulkData::FSharedBufferWithID(MakeSharedBufferFromArray(MoveTemp(DecodedSheet.Pixels))));
+	DecodedSheet.Pixels.Reset();
 	
 	FAssetRegistryModule::AssetCreated(NewTexture);
 	Package->MarkPackageDirty();
 	
-	UE_LOG(LogCharacterCreation, Log, TEXT("Successfully imported texture: %s (%dx%d)"), *AssetName, Width, Height);
+	UE_LOG(LogCharacterCreation, Verbose, TEXT("Successfully imported texture: %s (%dx%d)"), *AssetName, Width, Height);
 	return NewTexture;
 #else
 	UE_LOG(LogCharacterCreation, Error, TEXT("Import functionality is only available in editor builds"));
@@ -242,7 +719,7 @@ bool USpriteSheetProcessor::ApplyPaper2DTextureSettings(UTexture2D* Texture)
 	Texture->PowerOfTwoMode = ETexturePowerOfTwoSetting::None; // Allow non-power-of-2
 	Texture->NeverStream = true; // Keep full resolution in memory
 	
-	UE_LOG(LogCharacterCreation, Log, TEXT("Applied Paper2D texture settings to: %s"), *Texture->GetName());
+	UE_LOG(LogCharacterCreation, Verbose, TEXT("Applied Paper2D texture settings to: %s"), *Texture->GetName());
 	UE_LOG(LogCharacterCreation, Verbose, TEXT("Texture size after settings: %dx%d"), Texture->GetSizeX(), Texture->GetSizeY());
 	
 	Texture->PostEditChange();
@@ -266,8 +743,10 @@ TArray<UPaperSprite*> USpriteSheetProcessor::ExtractSprites(UTexture2D* Texture,
 	}
 
 #if WITH_EDITOR
-	int32 TextureWidth = Texture->GetSizeX();
-	int32 TextureHeight = Texture->GetSizeY();
+	// Textures created by ImportTexture only carry pixels in their source
+	const bool bUseTextureSource = Texture->Source.IsValid();
+	int32 TextureWidth = bUseTextureSource ? Texture->Source.GetSizeX() : Texture->GetSizeX();
+	int32 TextureHeight = bUseTextureSource ? Texture->Source.GetSizeY() : Texture->GetSizeY();
 	
 	int32 SpriteWidth = TextureWidth / SpriteInfo.Columns;
 	int32 SpriteHeight = TextureHeight / SpriteInfo.Rows;
@@ -276,15 +755,29 @@ TArray<UPaperSprite*> USpriteSheetProcessor::ExtractSprites(UTexture2D* Texture,
 	UE_LOG(LogCharacterCreation, Verbose, TEXT("DEBUG: Expected grid: %dx%d"), SpriteInfo.Columns, SpriteInfo.Rows);
 	UE_LOG(LogCharacterCreation, Verbose, TEXT("DEBUG: Calculated sprite size: %dx%d"), SpriteWidth, SpriteHeight);
 	
-	UE_LOG(LogCharacterCreation, Log, TEXT("Extracting sprites from %dx%d texture, sprite size: %dx%d"), 
+	UE_LOG(LogCharacterCreation, Verbose, TEXT("Extracting sprites from %dx%d texture, sprite size: %dx%d"), 
 		TextureWidth, TextureHeight, SpriteWidth, SpriteHeight);
 
 	// Ensure we're on the game thread for texture access
 	check(IsInGameThread());
+
+	if (SpriteInfo.bUseSheetAtlas)
+	{
+		return ExtractAtlasSprites(Texture, SpriteInfo.Columns, SpriteInfo.Rows, SpriteWidth, SpriteHeight);
+	}
 	
 	// Access the source texture data
-	FTexture2DMipMap& Mip = Texture->GetPlatformData()->Mips[0];
-	uint8* SourceData = static_cast<uint8*>(Mip.BulkData.Lock(LOCK_READ_ONLY));
+	FTexture2DMipMap* Mip = nullptr;
+	const uint8* SourceData = nullptr;
+	if (bUseTextureSource)
+	{
+		SourceData = Texture->Source.LockMipReadOnly(0);
+	}
+	else if (Texture->GetPlatformData() && Texture->GetPlatformData()->Mips.Num() > 0)
+	{
+		Mip = &Texture->GetPlatformData()->Mips[0];
+		SourceData = static_cast<const uint8*>(Mip->BulkData.LockReadOnly());
+	}
 	
 	if (!SourceData)
 	{
@@ -292,32 +785,48 @@ TArray<UPaperSprite*> USpriteSheetProcessor::ExtractSprites(UTexture2D* Texture,
 		return ExtractedSprites;
 	}
 
-	// Determine pixel format size
-	int32 BytesPerPixel = 4; // Assuming RGBA8
-	EPixelFormat PixelFormat = Texture->GetPixelFormat();
-	if (PixelFormat == PF_B8G8R8A8)
-	{
-		BytesPerPixel = 4;
-	}
-	else if (PixelFormat == PF_G8)
+	// Every cell is converted to BGRA8 by the blitter, so any layout it can read slices correctly
+	ESpritePixelLayout SourceLayout = ESpritePixelLayout::BGRA8;
+	const bool bKnownLayout = bUseTextureSource
+		? FSpritePixelBlit::LayoutFromSourceFormat(Texture->Source.GetFormat(), SourceLayout)
+		: FSpritePixelBlit::LayoutFromPixelFormat(Texture->GetPixelFormat(), SourceLayout);
+	if (!bKnownLayout)
 	{
-		BytesPerPixel = 1;
-	}
-	else
-	{
-		UE_LOG(LogCharacterCreation, Warning, TEXT("Unsupported pixel format, assuming 4 bytes per pixel"));
+		UE_LOG(LogCharacterCreation, Error, TEXT("Unsupported pixel format for sprite extraction: %s"), *Texture->GetName());
+		if (bUseTextureSource)
+		{
+			Texture->Source.UnlockMip(0);
+		}
+		else
+		{
+			Mip->BulkData.Unlock();
+		}
+		return ExtractedSprites;
 	}
 
+	// The alpha scan needs 4-byte pixels with alpha last
+	const bool bCanTrim = SpriteInfo.bTrimFrames && (SourceLayout == ESpritePixelLayout::BGRA8 || SourceLayout == ESpritePixelLayout::RGBA8);
+
 	for (int32 Row = 0; Row < SpriteInfo.Rows; Row++)
 	{
 		for (int32 Col = 0; Col < SpriteInfo.Columns; Col++)
 		{
 			FString SpriteName = FString::Printf(TEXT("%s_R%d_C%d"), *Texture->GetName(), Row, Col);
-			FString PackagePath = FString::Printf(TEXT("/Game/Sprites/%s"), *SpriteName);
+
+			FIntRect TrimRect(0, 0, SpriteWidth, SpriteHeight);
+			if (bCanTrim)
+			{
+				TrimRect = FSpritePixelBlit::FindOpaqueBounds(SourceData, TextureWidth, Col * SpriteWidth, Row * SpriteHeight, SpriteWidth, SpriteHeight);
+				if (TrimRect.Area() == 0)
+				{
+					TrimRect = FIntRect(0, 0, 1, 1);
+				}
+			}
 			
 			// Create new texture for this sprite
 			UTexture2D* SpriteTexture = CreateSpriteTexture(SourceData, TextureWidth, TextureHeight, 
-				Col * SpriteWidth, Row * SpriteHeight, SpriteWidth, SpriteHeight, BytesPerPixel, SpriteName);
+				Col * SpriteWidth + TrimRect.Min.X, Row * SpriteHeight + TrimRect.Min.Y, TrimRect.Width(), TrimRect.Height(),
+				SourceLayout, SpriteInfo.bPremultiplyAlpha, SpriteName);
 			
 			if (!SpriteTexture)
 			{
@@ -325,113 +834,295 @@ TArray<UPaperSprite*> USpriteSheetProcessor::ExtractSprites(UTexture2D* Texture,
 				continue;
 			}
 
-			UPackage* SpritePackage = CreatePackage(*PackagePath);
-			if (!SpritePackage)
+			UPaperSprite* NewSprite = CreateSprite(SpriteTexture, SpriteName, FVector2D::ZeroVector, SpriteWidth, SpriteHeight, TrimRect);
+			if (!NewSprite)
+			{
+				continue;
+			}
+
+			ExtractedSprites.Add(NewSprite);
+			
+			UE_LOG(LogCharacterCreation, Verbose, TEXT("Created sprite: %s at (%d, %d) size (%dx%d)"), 
+				*SpriteName, Col * SpriteWidth, Row * SpriteHeight, SpriteWidth, SpriteHeight);
+		}
+	}
+
+	// Unlock the source texture data
+	if (bUseTextureSource)
+	{
+		Texture->Source.UnlockMip(0);
+	}
+	else
+	{
+		Mip->BulkData.Unlock();
+	}
+
+	UE_LOG(LogCharacterCreation, Verbose, TEXT("Extracted %d sprites total"), ExtractedSprites.Num());
+#endif
+
+	return ExtractedSprites;
+}
+
+TArray<UPaperSprite*> USpriteSheetProcessor::ExtractSpritesFromDecoded(UTexture2D* SheetTexture, const FDecodedSpriteSheet& DecodedSheet, const FSpriteSheetInfo& SpriteInfo)
+{
+	TArray<UPaperSprite*> ExtractedSprites;
+
+#if WITH_EDITOR
+	check(IsInGameThread());
+
+	const int32 SpriteWidth = DecodedSheet.CellWidth;
+	const int32 SpriteHeight = DecodedSheet.CellHeight;
+	const FString SheetName = SheetTexture->GetName();
+
+	const bool bShareFrames = SpriteInfo.bShareDuplicateFrames && DecodedSheet.CellHashes.Num() == DecodedSheet.CellBounds.Num();
+	FSpriteFrameCache& FrameCache = GetFrameCache();
+	int32 SharedWithinSheet = 0;
+	int32 SharedAcrossSheets = 0;
+	BorrowedSheetNames.Reset();
+
+	UE_LOG(LogCharacterCreation, Verbose, TEXT("Extracting sprites from %dx%d texture, sprite size: %dx%d"), 
+		DecodedSheet.Width, DecodedSheet.Height, SpriteWidth, SpriteHeight);
+
+	for (int32 Row = 0; Row < DecodedSheet.Rows; Row++)
+	{
+		for (int32 Col = 0; Col < DecodedSheet.Columns; Col++)
+		{
+			FString SpriteName = FString::Printf(TEXT("%s_R%d_C%d"), *SheetName, Row, Col);
+
+			const int32 CellIndex = Row * DecodedSheet.Columns + Col;
+			const FIntRect& TrimRect = DecodedSheet.CellBounds[CellIndex];
+
+			// Identical content already has a sprite; point this cell at it instead of creating another asset
+			if (bShareFrames)
 			{
-				UE_LOG(LogCharacterCreation, Error, TEXT("Failed to create sprite package: %s"), *PackagePath);
-				continue;
+				FString OwnerSheet;
+				if (UPaperSprite* ExistingSprite = FrameCache.Find(DecodedSheet.CellHashes[CellIndex], &OwnerSheet))
+				{
+					ExtractedSprites.Add(ExistingSprite);
+					if (OwnerSheet == SheetName)
+					{
+						SharedWithinSheet++;
+					}
+					else
+					{
+						SharedAcrossSheets++;
+						BorrowedSheetNames.AddUnique(OwnerSheet);
+					}
+
+					UE_LOG(LogCharacterCreation, Verbose, TEXT("Reusing sprite %s for %s"), *ExistingSprite->GetName(), *SpriteName);
+					continue;
+				}
 			}
 
-			UPaperSprite* NewSprite = NewObject<UPaperSprite>(SpritePackage, *SpriteName, RF_Public | RF_Standalone);
-			if (!NewSprite)
+			UPaperSprite* NewSprite = nullptr;
+			if (SpriteInfo.bUseSheetAtlas)
 			{
-				UE_LOG(LogCharacterCreation, Error, TEXT("Failed to create sprite: %s"), *SpriteName);
-				continue;
+				// Trimmed atlas sprites keep the full texture but draw less transparent area
+				const FVector2D SourceUV(Col * SpriteWidth + TrimRect.Min.X, Row * SpriteHeight + TrimRect.Min.Y);
+				NewSprite = CreateSprite(SheetTexture, SpriteName, SourceUV, SpriteWidth, SpriteHeight, TrimRect);
 			}
-
-			// Use reflection to access protected properties
-			FProperty* SourceTextureProperty = UPaperSprite::StaticClass()->FindPropertyByName(TEXT("SourceTexture"));
-			FProperty* SourceUVProperty = UPaperSprite::StaticClass()->FindPropertyByName(TEXT("SourceUV"));
-			FProperty* SourceDimensionProperty = UPaperSprite::StaticClass()->FindPropertyByName(TEXT("SourceDimension"));
-			
-			if (SourceTextureProperty && SourceUVProperty && SourceDimensionProperty)
+			else
 			{
-				// Set source texture to the extracted sprite texture
-				TSoftObjectPtr<UTexture2D>* SourceTexturePtr = SourceTextureProperty->ContainerPtrToValuePtr<TSoftObjectPtr<UTexture2D>>(NewSprite);
-				if (SourceTexturePtr)
-				{
-					*SourceTexturePtr = SpriteTexture;
-				}
-				
-				// Set source UV to origin since we have individual textures now
-				FVector2D* SourceUVPtr = SourceUVProperty->ContainerPtrToValuePtr<FVector2D>(NewSprite);
-				if (SourceUVPtr)
-				{
-					*SourceUVPtr = FVector2D::ZeroVector;
-				}
-				
-				// Set source dimension to full texture size
-				FVector2D* SourceDimensionPtr = SourceDimensionProperty->ContainerPtrToValuePtr<FVector2D>(NewSprite);
-				if (SourceDimensionPtr)
+				// Cell buffers are already trimmed, tightly packed BGRA8 (and premultiplied if requested),
+				// so the whole buffer is the copy region
+				const uint8* CellData = DecodedSheet.Cells[CellIndex].GetData();
+				UTexture2D* SpriteTexture = CreateSpriteTexture(CellData, TrimRect.Width(), TrimRect.Height(), 
+					0, 0, TrimRect.Width(), TrimRect.Height(), ESpritePixelLayout::BGRA8, false, SpriteName);
+
+				if (!SpriteTexture)
 				{
-					*SourceDimensionPtr = FVector2D(SpriteWidth, SpriteHeight);
+					UE_LOG(LogCharacterCreation, Error, TEXT("Failed to create sprite texture: %s"), *SpriteName);
+					continue;
 				}
-				
-				// Set pivot to center
-				NewSprite->SetPivotMode(ESpritePivotMode::Center_Center, FVector2D::ZeroVector);
-				
-				// Rebuild the sprite data
-				NewSprite->RebuildData();
+
+				NewSprite = CreateSprite(SpriteTexture, SpriteName, FVector2D::ZeroVector, SpriteWidth, SpriteHeight, TrimRect);
 			}
-			else
+
+			if (!NewSprite)
 			{
-				UE_LOG(LogCharacterCreation, Error, TEXT("Failed to find sprite properties via reflection"));
+				continue;
 			}
-			
-			NewSprite->PostEditChange();
-			FAssetRegistryModule::AssetCreated(NewSprite);
-			SpritePackage->MarkPackageDirty();
-			
-			// Save the sprite package to disk
-			FSavePackageArgs SaveArgs;
-			SaveArgs.TopLevelFlags = EObjectFlags::RF_Public | EObjectFlags::RF_Standalone;
-			SaveArgs.Error = GError;
-			SaveArgs.SaveFlags = SAVE_NoError;
-			bool bSaved = UPackage::SavePackage(SpritePackage, NewSprite, 
-				*FPackageName::LongPackageNameToFilename(PackagePath, FPackageName::GetAssetPackageExtension()), 
-				SaveArgs);
-			
-			if (bSaved)
+
+			ExtractedSprites.Add(NewSprite);
+			if (bShareFrames)
 			{
-				UE_LOG(LogCharacterCreation, Log, TEXT("✓ Saved sprite package to disk: %s"), *PackagePath);
+				FrameCache.Add(DecodedSheet.CellHashes[CellIndex], NewSprite, SheetName);
 			}
-			else
+
+			UE_LOG(LogCharacterCreation, Verbose, TEXT("Created sprite: %s at (%d, %d) size (%dx%d)"), 
+				*SpriteName, Col * SpriteWidth + TrimRect.Min.X, Row * SpriteHeight + TrimRect.Min.Y, TrimRect.Width(), TrimRect.Height());
+		}
+	}
+
+	UE_LOG(LogCharacterCreation, Verbose, TEXT("Extracted %d sprites total"), ExtractedSprites.Num());
+
+	if (bShareFrames)
+	{
+		UE_LOG(LogCharacterCreation, Log, TEXT("Dedupe %s: %d unique frames, %d shared within sheet, %d shared from other sheets"),
+			*SheetName, ExtractedSprites.Num() - SharedWithinSheet - SharedAcrossSheets, SharedWithinSheet, SharedAcrossSheets);
+	}
+#endif
+
+	return ExtractedSprites;
+}
+
+TArray<UPaperSprite*> USpriteSheetProcessor::ExtractAtlasSprites(UTexture2D* SheetTexture, int32 Columns, int32 Rows, int32 SpriteWidth, int32 SpriteHeight)
+{
+	TArray<UPaperSprite*> ExtractedSprites;
+
+#if WITH_EDITOR
+	// Every sprite shares the sheet texture, so a character costs one texture instead of one per cell
+	const FIntRect FullCell(0, 0, SpriteWidth, SpriteHeight);
+	for (int32 Row = 0; Row < Rows; Row++)
+	{
+		for (int32 Col = 0; Col < Columns; Col++)
+		{
+			FString SpriteName = FString::Printf(TEXT("%s_R%d_C%d"), *SheetTexture->GetName(), Row, Col);
+			FVector2D SourceUV(Col * SpriteWidth, Row * SpriteHeight);
+
+			UPaperSprite* NewSprite = CreateSprite(SheetTexture, SpriteName, SourceUV, SpriteWidth, SpriteHeight, FullCell);
+			if (!NewSprite)
 			{
-				UE_LOG(LogCharacterCreation, Warning, TEXT("✗ Failed to save sprite package: %s"), *PackagePath);
+				continue;
 			}
-			
+
 			ExtractedSprites.Add(NewSprite);
-			
-			UE_LOG(LogCharacterCreation, Log, TEXT("Created sprite: %s at (%d, %d) size (%dx%d)"), 
-				*SpriteName, Col * SpriteWidth, Row * SpriteHeight, SpriteWidth, SpriteHeight);
+
+			UE_LOG(LogCharacterCreation, Verbose, TEXT("Created atlas sprite: %s at (%.0f, %.0f) size (%dx%d)"), 
+				*SpriteName, SourceUV.X, SourceUV.Y, SpriteWidth, SpriteHeight);
 		}
 	}
 
-	// Unlock the source texture data
-	Mip.BulkData.Unlock();
-
-	UE_LOG(LogCharacterCreation, Log, TEXT("Extracted %d sprites total"), ExtractedSprites.Num());
+	UE_LOG(LogCharacterCreation, Verbose, TEXT("Extracted %d atlas sprites from %s"), ExtractedSprites.Num(), *SheetTexture->GetName());
 #endif
 
 	return ExtractedSprites;
 }
 
+bool USpriteSheetProcessor::SaveSheetTexture(UTexture2D* SheetTexture)
+{
+#if WITH_EDITOR
+	UPackage* Package = SheetTexture->GetPackage();
+	FString PackageName = Package->GetName();
+
+	SheetTexture->PostEditChange();
+
+	UE_LOG(LogCharacterCreation, Log, TEXT("Queued sheet texture package: %s"), *PackageName);
+	return SaveQueue.Enqueue(Package, SheetTexture);
+#else
+	return false;
+#endif
+}
+
+UPaperSprite* USpriteSheetProcessor::CreateSprite(UTexture2D* SourceTexture, const FString& SpriteName, const FVector2D& SourceUV, int32 SpriteWidth, int32 SpriteHeight, const FIntRect& TrimRect)
+{
+#if WITH_EDITOR
+	const FPaperPropertyBindings* Paper = FPaperPropertyBindings::Get();
+	if (!Paper)
+	{
+		UE_LOG(LogCharacterCreation, Error, TEXT("Cannot create sprite %s: Paper2D properties are not bound"), *SpriteName);
+		return nullptr;
+	}
+
+	FString PackagePath = FString::Printf(TEXT("/Game/Sprites/%s"), *SpriteName);
+
+	UPackage* SpritePackage = CreatePackage(*PackagePath);
+	if (!SpritePackage)
+	{
+		UE_LOG(LogCharacterCreation, Error, TEXT("Failed to create sprite package: %s"), *PackagePath);
+		return nullptr;
+	}
+
+	UPaperSprite* NewSprite = NewObject<UPaperSprite>(SpritePackage, *SpriteName, RF_Public | RF_Standalone);
+	if (!NewSprite)
+	{
+		UE_LOG(LogCharacterCreation, Error, TEXT("Failed to create sprite: %s"), *SpriteName);
+		return nullptr;
+	}
+
+	// Protected fields, bound once per process
+	Paper->SourceTexture(NewSprite) = SourceTexture;
+
+	// Origin for per-cell textures, cell offset in pixels for atlas sprites
+	Paper->SourceUV(NewSprite) = SourceUV;
+
+	// Set source dimension to the (possibly trimmed) region
+	Paper->SourceDimension(NewSprite) = FVector2D(TrimRect.Width(), TrimRect.Height());
+
+	// Record where the region sat in the untrimmed cell so pivot modes resolve against the full cell
+	// and trimmed frames stay anchored exactly where the untrimmed ones were
+	const bool bTrimmed = TrimRect.Min != FIntPoint::ZeroValue || TrimRect.Width() != SpriteWidth || TrimRect.Height() != SpriteHeight;
+	NewSprite->SetTrim(bTrimmed, FVector2D(TrimRect.Min), FVector2D(SpriteWidth, SpriteHeight), false);
+	
+	// Set pivot to center
+	NewSprite->SetPivotMode(ESpritePivotMode::Center_Center, FVector2D::ZeroVector);
+	
+	// Rebuild the sprite data
+	{
+		SPRITE_PIPELINE_SCOPE(SpriteBuild);
+		NewSprite->RebuildData();
+	}
+	
+	{
+		SPRITE_PIPELINE_SCOPE(PostEditChange);
+		NewSprite->PostEditChange();
+	}
+	FAssetRegistryModule::AssetCreated(NewSprite);
+	SpritePackage->MarkPackageDirty();
+	
+	// Written with the rest of the batch (or immediately when called outside ProcessSpriteSheet)
+	SaveQueue.Enqueue(SpritePackage, NewSprite);
+
+	return NewSprite;
+#else
+	UE_LOG(LogCharacterCreation, Error, TEXT("Sprite creation is only available in editor builds"));
+	return nullptr;
+#endif
+}
+
 TArray<UPaperFlipbook*> USpriteSheetProcessor::CreateAnimations(const TArray<UPaperSprite*>& Sprites, const FSpriteSheetInfo& SpriteInfo, const FString& CharacterName)
 {
+	const FString RawAssetPath = FPaths::ProjectDir() + TEXT("RawAssets/") + CharacterName + TEXT(".png");
+	TSharedPtr<const FSpriteSheetLayout> Layout = FSpriteSheetLayoutCache::Resolve(RawAssetPath, SpriteInfo.Rows);
+	if (!Layout.IsValid())
+	{
+		return TArray<UPaperFlipbook*>();
+	}
+
+	return CreateLayoutAnimations(Sprites, TArray<FSpriteFrameHash>(), SpriteInfo.Columns, SpriteInfo.Rows, *Layout, CharacterName);
+}
+
+TArray<UPaperFlipbook*> USpriteSheetProcessor::CreateLayoutAnimations(const TArray<UPaperSprite*>& Sprites, const TArray<FSpriteFrameHash>& CellHashes, int32 Columns, int32 Rows, const FSpriteSheetLayout& Layout, const FString& CharacterName)
+{
+	SPRITE_PIPELINE_SCOPE(Flipbooks);
+
 	TArray<UPaperFlipbook*> CreatedAnimations;
 
-	if (Sprites.Num() != SpriteInfo.Rows * SpriteInfo.Columns)
+	if (Sprites.Num() != Rows * Columns)
 	{
 		UE_LOG(LogCharacterCreation, Error, TEXT("Sprite count mismatch. Expected: %d, Got: %d"), 
-			SpriteInfo.Rows * SpriteInfo.Columns, Sprites.Num());
+			Rows * Columns, Sprites.Num());
+		return CreatedAnimations;
+	}
+
+	FString LayoutError;
+	if (!Layout.Validate(Columns, Rows, LayoutError))
+	{
+		UE_LOG(LogCharacterCreation, Error, TEXT("Sheet layout for %s does not match its grid: %s"), *CharacterName, *LayoutError);
 		return CreatedAnimations;
 	}
 
 #if WITH_EDITOR
-	for (int32 Row = 0; Row < SpriteInfo.Rows; Row++)
+	const FPaperPropertyBindings* Paper = FPaperPropertyBindings::Get();
+	if (!Paper)
 	{
-		EAnimationType AnimType = static_cast<EAnimationType>(Row);
-		FString AnimationName = GetAnimationName(AnimType, CharacterName);
+		UE_LOG(LogCharacterCreation, Error, TEXT("Cannot create animations: Paper2D properties are not bound"));
+		return CreatedAnimations;
+	}
+
+	for (const FSpriteAnimationLayout& Animation : Layout.Animations)
+	{
+		FString AnimationName = GetAnimationName(Animation.Name, CharacterName);
 		FString PackagePath = FString::Printf(TEXT("/Game/Animations/%s"), *AnimationName);
 		
 		UPackage* FlipbookPackage = CreatePackage(*PackagePath);
@@ -448,116 +1139,154 @@ TArray<UPaperFlipbook*> USpriteSheetProcessor::CreateAnimations(const TArray<UPa
 			continue;
 		}
 
-		for (int32 Col = 0; Col < SpriteInfo.Columns; Col++)
+		const int32 NumFrames = Layout.GetNumFrames(Animation, Columns);
+		TArray<FPaperFlipbookKeyFrame>& KeyFrames = Paper->KeyFrames(NewFlipbook);
+		KeyFrames.Reserve(NumFrames);
+
+		// Frames whose sprite failed to create still hold the pose before them, so the clip keeps its length
+		int32 LastCellIndex = INDEX_NONE;
+		int32 LeadingFrameRun = 0;
+		for (int32 Frame = 0; Frame < NumFrames; Frame++)
 		{
-			int32 SpriteIndex = Row * SpriteInfo.Columns + Col;
-			if (SpriteIndex < Sprites.Num() && Sprites[SpriteIndex])
+			const int32 CellIndex = Animation.Row * Columns + Animation.FirstFrame + Frame;
+			UPaperSprite* Sprite = Sprites[CellIndex];
+			const int32 FrameRun = Layout.GetFrameRun(Animation, Frame);
+			if (!Sprite)
 			{
-				FPaperFlipbookKeyFrame KeyFrame;
-				KeyFrame.Sprite = Sprites[SpriteIndex];
-				KeyFrame.FrameRun = 1;
-				
-#if WITH_EDITOR
-				// Use reflection to access protected KeyFrames array
-				FProperty* KeyFramesProperty = UPaperFlipbook::StaticClass()->FindPropertyByName(TEXT("KeyFrames"));
-				if (KeyFramesProperty)
+				if (KeyFrames.Num() > 0)
 				{
-					TArray<FPaperFlipbookKeyFrame>* KeyFramesPtr = KeyFramesProperty->ContainerPtrToValuePtr<TArray<FPaperFlipbookKeyFrame>>(NewFlipbook);
-					if (KeyFramesPtr)
-					{
-						KeyFramesPtr->Add(KeyFrame);
-					}
+					KeyFrames.Last().FrameRun += FrameRun;
 				}
-#endif
+				else
+				{
+					LeadingFrameRun += FrameRun;
+				}
+				continue;
 			}
-		}
 
-#if WITH_EDITOR
-		// Use reflection to access protected FramesPerSecond property
-		FProperty* FPSProperty = UPaperFlipbook::StaticClass()->FindPropertyByName(TEXT("FramesPerSecond"));
-		if (FPSProperty)
-		{
-			float* FPSPtr = FPSProperty->ContainerPtrToValuePtr<float>(NewFlipbook);
-			if (FPSPtr)
+			// Identical cells become one longer key frame, whether or not -noshare gave them separate sprites
+			const bool bSameAsLast = CellHashes.IsValidIndex(CellIndex) && CellHashes.IsValidIndex(LastCellIndex)
+				? CellHashes[CellIndex] == CellHashes[LastCellIndex]
+				: KeyFrames.Num() > 0 && KeyFrames.Last().Sprite == Sprite;
+			if (KeyFrames.Num() > 0 && bSameAsLast)
 			{
-				*FPSPtr = 12.0f;
+				KeyFrames.Last().FrameRun += FrameRun;
+				continue;
 			}
+
+			FPaperFlipbookKeyFrame& KeyFrame = KeyFrames.AddDefaulted_GetRef();
+			KeyFrame.Sprite = Sprite;
+			KeyFrame.FrameRun = FrameRun + LeadingFrameRun;
+			LeadingFrameRun = 0;
+			LastCellIndex = CellIndex;
+		}
+		KeyFrames.Shrink();
+
+		Paper->FramesPerSecond(NewFlipbook) = Animation.FramesPerSecond;
+
+		{
+			SPRITE_PIPELINE_SCOPE(PostEditChange);
+			NewFlipbook->PostEditChange();
 		}
-		NewFlipbook->PostEditChange();
 		FAssetRegistryModule::AssetCreated(NewFlipbook);
 		FlipbookPackage->MarkPackageDirty();
 		
-		// Force save the package to disk
-		FSavePackageArgs SaveArgs;
-		SaveArgs.TopLevelFlags = EObjectFlags::RF_Public | EObjectFlags::RF_Standalone;
-		SaveArgs.Error = GError;
-		SaveArgs.SaveFlags = SAVE_NoError;
-		UPackage::SavePackage(FlipbookPackage, NewFlipbook, 
-			*FPackageName::LongPackageNameToFilename(PackagePath, FPackageName::GetAssetPackageExtension()), 
-			SaveArgs);
-		
-		UE_LOG(LogCharacterCreation, Warning, TEXT("✓ Saved flipbook package to disk: %s"), *PackagePath);
-#endif
+		SaveQueue.Enqueue(FlipbookPackage, NewFlipbook);
 		
 		CreatedAnimations.Add(NewFlipbook);
 		
-		UE_LOG(LogCharacterCreation, Log, TEXT("Created animation: %s with %d frames"), 
-*AnimationName, NewFlipbook->GetNumKeyFrames());
+		UE_LOG(LogCharacterCreation, Verbose, TEXT("Created animation: %s with %d key frames (%d frames, %.2fs)"), 
+*AnimationName, NewFlipbook->GetNumKeyFrames(), NewFlipbook->GetNumFrames(), NewFlipbook->GetTotalDuration());
 	}
 
-	UE_LOG(LogCharacterCreation, Log, TEXT("Created %d animations total"), CreatedAnimations.Num());
+	UE_LOG(LogCharacterCreation, Verbose, TEXT("Created %d animations total"), CreatedAnimations.Num());
 #endif
 
 	return CreatedAnimations;
 }
 
-FString USpriteSheetProcessor::GetAnimationName(EAnimationType AnimType, const FString& CharacterName) const
+UWarriorAnimationSet* USpriteSheetProcessor::CreateAnimationSet(const FString& SheetName, const FSpriteSheetLayout& Layout, const TArray<UPaperFlipbook*>& Flipbooks)
 {
-	FString BaseAnimName;
-	switch (AnimType)
-	{
-		case EAnimationType::Idle:
-			BaseAnimName = TEXT("Idle");
-			break;
-		case EAnimationType::Move:
-			BaseAnimName = TEXT("Move");
-			break;
-		case EAnimationType::AttackSideways:
-			BaseAnimName = TEXT("AttackSideways");
-			break;
-		case EAnimationType::AttackSideways2:
-			BaseAnimName = TEXT("AttackSideways2");
-			break;
-		case EAnimationType::AttackDownwards:
-			BaseAnimName = TEXT("AttackDownwards");
-			break;
-		case EAnimationType::AttackDownwards2:
-			BaseAnimName = TEXT("AttackDownwards2");
-			break;
-		case EAnimationType::AttackUpwards:
-			BaseAnimName = TEXT("AttackUpwards");
-			break;
-		case EAnimationType::AttackUpwards2:
-			BaseAnimName = TEXT("AttackUpwards2");
-			break;
-		default:
-			BaseAnimName = TEXT("Unknown");
-			break;
+#if WITH_EDITOR
+	const UEnum* AnimationEnum = StaticEnum<EAnimationType>();
+
+	TMap<EAnimationType, TObjectPtr<UPaperFlipbook>> Animations;
+	TMap<EAnimationType, bool> Looping;
+	for (const FSpriteAnimationLayout& Animation : Layout.Animations)
+	{
+		const int64 AnimationType = AnimationEnum->GetValueByNameString(Animation.Name, EGetByNameFlags::None);
+		if (AnimationType == INDEX_NONE)
+		{
+			continue;
+		}
+
+		const FName FlipbookName(*GetAnimationName(Animation.Name, SheetName));
+		UPaperFlipbook* const* Flipbook = Flipbooks.FindByPredicate([&FlipbookName](const UPaperFlipbook* Candidate)
+		{
+			return Candidate && Candidate->GetFName() == FlipbookName;
+		});
+		if (Flipbook)
+		{
+			Animations.Add(static_cast<EAnimationType>(AnimationType), *Flipbook);
+			// UPaperFlipbook has no loop flag of its own; the component playing it reads this one
+			Looping.Add(static_cast<EAnimationType>(AnimationType), Animation.bLooping);
+		}
 	}
-	
+
+	// Sheets with a fully custom layout have nothing a warrior can play
+	if (Animations.Num() == 0)
+	{
+		return nullptr;
+	}
+
+	const FString PackagePath = UWarriorAnimationSet::GetAssetPath(SheetName);
+	UPackage* SetPackage = CreatePackage(*PackagePath);
+	if (!SetPackage)
+	{
+		UE_LOG(LogCharacterCreation, Error, TEXT("Failed to create animation set package: %s"), *PackagePath);
+		return nullptr;
+	}
+
+	UWarriorAnimationSet* AnimationSet = NewObject<UWarriorAnimationSet>(SetPackage, *UWarriorAnimationSet::GetAssetName(SheetName), RF_Public | RF_Standalone);
+	AnimationSet->Animations = MoveTemp(Animations);
+	AnimationSet->Looping = MoveTemp(Looping);
+
+	FAssetRegistryModule::AssetCreated(AnimationSet);
+	SetPackage->MarkPackageDirty();
+	SaveQueue.Enqueue(SetPackage, AnimationSet);
+
+	UE_LOG(LogCharacterCreation, Verbose, TEXT("Created animation set %s with %d of %d animation types"),
+		*AnimationSet->GetName(), AnimationSet->Animations.Num(), NumAnimationTypes);
+	return AnimationSet;
+#else
+	return nullptr;
+#endif
+}
+
+FString USpriteSheetProcessor::GetAnimationName(const FString& BaseName, const FString& CharacterName) const
+{
 	// If character name is provided, append it to make unique animation names
 	if (!CharacterName.IsEmpty())
 	{
-		return FString::Printf(TEXT("%s_%s"), *BaseAnimName, *CharacterName);
+		return FString::Printf(TEXT("%s_%s"), *BaseName, *CharacterName);
 	}
 	
-	return BaseAnimName;
+	return BaseName;
 }
 
-UTexture2D* USpriteSheetProcessor::CreateSpriteTexture(uint8* SourceData, int32 SourceWidth, int32 SourceHeight, 
-	int32 StartX, int32 StartY, int32 SpriteWidth, int32 SpriteHeight, int32 BytesPerPixel, const FString& SpriteName)
+UTexture2D* USpriteSheetProcessor::CreateSpriteTexture(const uint8* SourceData, int32 SourceWidth, int32 SourceHeight, 
+	int32 StartX, int32 StartY, int32 SpriteWidth, int32 SpriteHeight, ESpritePixelLayout SourceLayout, bool bPremultiplyAlpha, const FString& SpriteName)
 {
 #if WITH_EDITOR
+	SPRITE_PIPELINE_SCOPE(SpriteTexture);
+
+	if (StartX < 0 || StartY < 0 || StartX + SpriteWidth > SourceWidth || StartY + SpriteHeight > SourceHeight)
+	{
+		UE_LOG(LogCharacterCreation, Error, TEXT("Sprite region (%d, %d) %dx%d is outside the %dx%d source: %s"),
+			StartX, StartY, SpriteWidth, SpriteHeight, SourceWidth, SourceHeight, *SpriteName);
+		return nullptr;
+	}
+
 	FString PackageName = FString::Printf(TEXT("/Game/Textures/%s"), *SpriteName);
 	FString AssetName = SpriteName;
 	
@@ -575,39 +1304,84 @@ UTexture2D* USpriteSheetProcessor::CreateSpriteTexture(uint8* SourceData, int32
 		return nullptr;
 	}
 
-	// Initialize texture properties
-	TUniquePtr<FTexturePlatformData> PlatformData = MakeUnique<FTexturePlatformData>();
-	PlatformData->SizeX = SpriteWidth;
-	PlatformData->SizeY = SpriteHeight;
-	PlatformData->PixelFormat = PF_B8G8R8A8;
-
-	// Create mip map
-	FTexture2DMipMap* Mip = new FTexture2DMipMap();
-	PlatformData->Mips.Add(Mip);
-	NewTexture->SetPlatformData(PlatformData.Release());
-	Mip->SizeX = SpriteWidth;
-	Mip->SizeY = SpriteHeight;
-	
 	// Ensure thread safety for texture operations
 	check(IsInGameThread());
+
+	// Convert the region straight into the buffer the texture source will own. UpdateResource
+	// below builds the platform mip from it, so no hand-filled mip copy is needed.
+	TArray64<uint8> SpritePixels;
+	SpritePixels.SetNumUninitialized(int64(SpriteWidth) * SpriteHeight * 4);
+	FSpritePipelineProfiler::Get().AddStageBytes(ESpritePipelineStage::SpriteTexture, SpritePixels.Num());
+	FSpritePixelBlit::BlitRegionToBGRA8(SourceData, SourceWidth, SourceLayout, StartX, StartY,
+		SpriteWidth, SpriteHeight, SpritePixels.GetData(), bPremultiplyAlpha);
+
+	// Apply Paper2D texture settings
+	NewTexture->Filter = TF_Nearest;
+	NewTexture->MipGenSettings = TMGS_NoMipmaps;
+	NewTexture->CompressionSettings = TC_EditorIcon;
+	NewTexture->SRGB = !bEncodingPaletteIndices;
+	NewTexture->LODGroup = TEXTUREGROUP_Pixels2D;
+	NewTexture->MaxTextureSize = 0;
+	NewTexture->PowerOfTwoMode = ETexturePowerOfTwoSetting::None;
+	NewTexture->NeverStream = true;
+
+	// Update and register the texture
+	NewTexture->Source.Init(SpriteWidth, SpriteHeight, 1, 1, TSF_BGRA8,
+		UE::Serialization::FEditorBulkData::FSharedBufferWithID(MakeSharedBufferFromArray(MoveTemp(SpritePixels))));
+	NewTexture->UpdateResource();
+	{
+		SPRITE_PIPELINE_SCOPE(PostEditChange);
+		NewTexture->PostEditChange();
+	}
 	
-	// Calculate size and allocate destination data
-	int32 DataSize = SpriteWidth * SpriteHeight * BytesPerPixel;
-	Mip->BulkData.Lock(LOCK_READ_WRITE);
-	uint8* DestData = static_cast<uint8*>(Mip->BulkData.Realloc(DataSize));
+	FAssetRegistryModule::AssetCreated(NewTexture);
+	Package->MarkPackageDirty();
+
+	SaveQueue.Enqueue(Package, NewTexture);
+
+	UE_LOG(LogCharacterCreation, Verbose, TEXT("Created sprite texture: %s (%dx%d)"), *AssetName, SpriteWidth, SpriteHeight);
+	return NewTexture;
+#else
+	UE_LOG(LogCharacterCreation, Error, TEXT("Texture creation is only available in editor builds"));
+	return nullptr;
+#endif
+}
+
+UTexture2D* USpriteSheetProcessor::CreatePaletteTexture(const FString& VariantName, const TArray<FColor>& Colors)
+{
+#if WITH_EDITOR
+	check(IsInGameThread());
 
-	// Copy pixel data from source texture region to destination (optimized row-by-row copy)
-	for (int32 Y = 0; Y < SpriteHeight; Y++)
+	const FString PackageName = FSpritePalette::GetPaletteTexturePath(VariantName);
+	UPackage* Package = CreatePackage(*PackageName);
+	if (!Package)
 	{
-		int32 SourceRowStart = ((StartY + Y) * SourceWidth + StartX) * BytesPerPixel;
-		int32 DestRowStart = Y * SpriteWidth * BytesPerPixel;
-		FMemory::Memcpy(&DestData[DestRowStart], &SourceData[SourceRowStart], SpriteWidth * BytesPerPixel);
+		UE_LOG(LogCharacterCreation, Error, TEXT("Failed to create palette package: %s"), *PackageName);
+		return nullptr;
 	}
 
-	Mip->BulkData.Unlock();
+	UTexture2D* NewTexture = NewObject<UTexture2D>(Package, *FPaths::GetBaseFilename(PackageName), RF_Public | RF_Standalone);
+	if (!NewTexture)
+	{
+		UE_LOG(LogCharacterCreation, Error, TEXT("Failed to create palette texture: %s"), *PackageName);
+		return nullptr;
+	}
+
+	// Always MaxColors wide so an index in [0, 255] maps to its own texel; unused entries stay transparent
+	TArray64<uint8> PalettePixels;
+	PalettePixels.SetNumZeroed(int64(FSpritePalette::MaxColors) * 4);
+	for (int32 ColorIndex = 0; ColorIndex < Colors.Num(); ColorIndex++)
+	{
+		uint8* Pixel = PalettePixels.GetData() + ColorIndex * 4;
+		Pixel[0] = Colors[ColorIndex].B;
+		Pixel[1] = Colors[ColorIndex].G;
+		Pixel[2] = Colors[ColorIndex].R;
+		Pixel[3] = Colors[ColorIndex].A;
+	}
 
-	// Apply Paper2D texture settings
 	NewTexture->Filter = TF_Nearest;
+	NewTexture->AddressX = TA_Clamp;
+	NewTexture->AddressY = TA_Clamp;
 	NewTexture->MipGenSettings = TMGS_NoMipmaps;
 	NewTexture->CompressionSettings = TC_EditorIcon;
 	NewTexture->SRGB = true;
@@ -616,37 +1390,95 @@ UTexture2D* USpriteSheetProcessor::CreateSpriteTexture(uint8* SourceData, int32
 	NewTexture->PowerOfTwoMode = ETexturePowerOfTwoSetting::None;
 	NewTexture->NeverStream = true;
 
-	// Update and register the texture
-	NewTexture->Source.Init(SpriteWidth, SpriteHeight, 1, 1, TSF_BGRA8, DestData);
+	NewTexture->Source.Init(FSpritePalette::MaxColors, 1, 1, 1, TSF_BGRA8,
+		UE::Serialization::FEditorBulkData::FSharedBufferWithID(MakeSharedBufferFromArray(MoveTemp(PalettePixels))));
 	NewTexture->UpdateResource();
 	NewTexture->PostEditChange();
-	
+
 	FAssetRegistryModule::AssetCreated(NewTexture);
 	Package->MarkPackageDirty();
 
-	// Save the texture package to disk
-	FSavePackageArgs SaveArgs;
-	SaveArgs.TopLevelFlags = EObjectFlags::RF_Public | EObjectFlags::RF_Standalone;
-	SaveArgs.Error = GError;
-	SaveArgs.SaveFlags = SAVE_NoError;
-	bool bSaved = UPackage::SavePackage(Package, NewTexture, 
-		*FPackageName::LongPackageNameToFilename(PackageName, FPackageName::GetAssetPackageExtension()), 
-		SaveArgs);
-	
-	if (bSaved)
+	SaveQueue.Enqueue(Package, NewTexture);
+
+	UE_LOG(LogCharacterCreation, Verbose, TEXT("Created palette texture: %s (%d colors)"), *PackageName, Colors.Num());
+	return NewTexture;
+#else
+	return nullptr;
+#endif
+}
+
+bool USpriteSheetProcessor::CreatePaletteMaterialIfMissing(UTexture2D* DefaultSpriteTexture, UTexture2D* DefaultPalette)
+{
+#if WITH_EDITOR
+	if (LoadObject<UMaterialInterface>(nullptr, FSpritePalette::MaterialPath, nullptr, LOAD_NoWarn | LOAD_Quiet))
 	{
-		UE_LOG(LogCharacterCreation, Log, TEXT("✓ Saved texture package to disk: %s"), *PackageName);
+		return true;
 	}
-	else
+
+	if (!DefaultSpriteTexture || !DefaultPalette)
 	{
-		UE_LOG(LogCharacterCreation, Warning, TEXT("✗ Failed to save texture package: %s"), *PackageName);
+		UE_LOG(LogCharacterCreation, Error, TEXT("Cannot create %s without a sprite and a palette texture"), FSpritePalette::MaterialPath);
+		return false;
 	}
 
-	UE_LOG(LogCharacterCreation, Log, TEXT("Created sprite texture: %s (%dx%d)"), *AssetName, SpriteWidth, SpriteHeight);
-	return NewTexture;
+	const FString PackageName = FSpritePalette::MaterialPath;
+	UPackage* Package = CreatePackage(*PackageName);
+	if (!Package)
+	{
+		UE_LOG(LogCharacterCreation, Error, TEXT("Failed to create material package: %s"), *PackageName);
+		return false;
+	}
+
+	UMaterial* Material = NewObject<UMaterial>(Package, *FPaths::GetBaseFilename(PackageName), RF_Public | RF_Standalone);
+	Material->SetShadingModel(MSM_Unlit);
+	Material->BlendMode = BLEND_Masked;
+	Material->TwoSided = true;
+
+	// Paper2D binds each sprite's texture to the SpriteTexture parameter. Index textures are linear.
+	UMaterialExpressionTextureSampleParameter2D* SpriteSample = NewObject<UMaterialExpressionTextureSampleParameter2D>(Material);
+	SpriteSample->ParameterName = TEXT("SpriteTexture");
+	SpriteSample->Texture = DefaultSpriteTexture;
+	SpriteSample->SamplerType = SAMPLERTYPE_LinearColor;
+
+	// u = index / 255 lands inside texel 'index' of the 256-wide palette with nearest filtering
+	UMaterialExpressionConstant* PaletteRow = NewObject<UMaterialExpressionConstant>(Material);
+	PaletteRow->R = 0.5f;
+
+	UMaterialExpressionAppendVector* PaletteUV = NewObject<UMaterialExpressionAppendVector>(Material);
+	PaletteUV->A.Connect(1, SpriteSample);
+	PaletteUV->B.Connect(0, PaletteRow);
+
+	UMaterialExpressionTextureSampleParameter2D* PaletteSample = NewObject<UMaterialExpressionTextureSampleParameter2D>(Material);
+	PaletteSample->ParameterName = FSpritePalette::ParameterName;
+	PaletteSample->Texture = DefaultPalette;
+	PaletteSample->SamplerType = SAMPLERTYPE_Color;
+	PaletteSample->Coordinates.Connect(0, PaletteUV);
+
+	// Keep the sprite component's tint working like the default Paper2D material
+	UMaterialExpressionVertexColor* VertexColor = NewObject<UMaterialExpressionVertexColor>(Material);
+	UMaterialExpressionMultiply* Tint = NewObject<UMaterialExpressionMultiply>(Material);
+	Tint->A.Connect(0, PaletteSample);
+	Tint->B.Connect(0, VertexColor);
+
+	for (UMaterialExpression* Expression : TArray<UMaterialExpression*>{ SpriteSample, PaletteRow, PaletteUV, PaletteSample, VertexColor, Tint })
+	{
+		Expression->Material = Material;
+		Material->GetExpressionCollection().AddExpression(Expression);
+	}
+
+	Material->GetEditorOnlyData()->EmissiveColor.Connect(0, Tint);
+	Material->GetEditorOnlyData()->OpacityMask.Connect(4, SpriteSample);
+
+	Material->PreEditChange(nullptr);
+	Material->PostEditChange();
+
+	FAssetRegistryModule::AssetCreated(Material);
+	Package->MarkPackageDirty();
+
+	UE_LOG(LogCharacterCreation, Verbose, TEXT("Created palette material: %s"), *PackageName);
+	return SaveQueue.Enqueue(Package, Material);
 #else
-	UE_LOG(LogCharacterCreation, Error, TEXT("Texture creation is only available in editor builds"));
-	return nullptr;
+	return false;
 #endif
 }
 
@@ -685,24 +1517,9 @@ UInputAction* USpriteSheetProcessor::CreateInputAction(const FString& ActionName
 	FAssetRegistryModule::AssetCreated(NewInputAction);
 	Package->MarkPackageDirty();
 
-	FSavePackageArgs SaveArgs;
-	SaveArgs.TopLevelFlags = EObjectFlags::RF_Public | EObjectFlags::RF_Standalone;
-	SaveArgs.Error = GError;
-	SaveArgs.SaveFlags = SAVE_NoError;
-	bool bSaved = UPackage::SavePackage(Package, NewInputAction, 
-		*FPackageName::LongPackageNameToFilename(PackagePath, FPackageName::GetAssetPackageExtension()), 
-		SaveArgs);
-	
-	if (bSaved)
-	{
-		UE_LOG(LogCharacterCreation, Log, TEXT("✓ Saved input action to disk: %s"), *PackagePath);
-	}
-	else
-	{
-		UE_LOG(LogCharacterCreation, Warning, TEXT("✗ Failed to save input action: %s"), *PackagePath);
-	}
+	SaveQueue.Enqueue(Package, NewInputAction);
 
-	UE_LOG(LogCharacterCreation, Log, TEXT("Created input action: %s"), *ActionName);
+	UE_LOG(LogCharacterCreation, Verbose, TEXT("Created input action: %s"), *ActionName);
 	return NewInputAction;
 #else
 	UE_LOG(LogCharacterCreation, Error, TEXT("Input action creation is only available in editor builds"));
@@ -841,24 +1658,9 @@ UInputMappingContext* USpriteSheetProcessor::CreateInputMappingContext(const FSt
 	FAssetRegistryModule::AssetCreated(NewMappingContext);
 	Package->MarkPackageDirty();
 
-	FSavePackageArgs SaveArgs;
-	SaveArgs.TopLevelFlags = EObjectFlags::RF_Public | EObjectFlags::RF_Standalone;
-	SaveArgs.Error = GError;
-	SaveArgs.SaveFlags = SAVE_NoError;
-	bool bSaved = UPackage::SavePackage(Package, NewMappingContext, 
-		*FPackageName::LongPackageNameToFilename(PackagePath, FPackageName::GetAssetPackageExtension()), 
-		SaveArgs);
-	
-	if (bSaved)
-	{
-		UE_LOG(LogCharacterCreation, Log, TEXT("✓ Saved input mapping context to disk: %s"), *PackagePath);
-	}
-	else
-	{
-		UE_LOG(LogCharacterCreation, Warning, TEXT("✗ Failed to save input mapping context: %s"), *PackagePath);
-	}
+	SaveQueue.Enqueue(Package, NewMappingContext);
 
-	UE_LOG(LogCharacterCreation, Log, TEXT("Created input mapping context: %s with %d mappings"), *ContextName, NewMappingContext->GetMappings().Num());
+	UE_LOG(LogCharacterCreation, Verbose, TEXT("Created input mapping context: %s with %d mappings"), *ContextName, NewMappingContext->GetMappings().Num());
 	return NewMappingContext;
 #else
 	UE_LOG(LogCharacterCreation, Error, TEXT("Input mapping context creation is only available in editor builds"));
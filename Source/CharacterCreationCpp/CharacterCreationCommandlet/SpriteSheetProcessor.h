@@ -9,21 +9,14 @@
 #include "CharacterCreationLog.h"
 #include "InputAction.h"
 #include "InputMappingContext.h"
+#include "SpritePackageSaveQueue.h"
+#include "SpritePixelBlit.h"
+#include "SpriteFrameCache.h"
+#include "SpritePalette.h"
+#include "SpriteSheetLayout.h"
+#include "WarriorAnimationSet.h"
 #include "SpriteSheetProcessor.generated.h"
 
-UENUM(BlueprintType)
-enum class EAnimationType : uint8
-{
-	Idle = 0,
-	Move = 1,
-	AttackSideways = 2,
-	AttackSideways2 = 3,
-	AttackDownwards = 4,
-	AttackDownwards2 = 5,
-	AttackUpwards = 6,
-	AttackUpwards2 = 7
-};
-
 USTRUCT(BlueprintType)
 struct FSpriteSheetInfo
 {
@@ -41,15 +34,77 @@ struct FSpriteSheetInfo
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	FString DestinationPath;
 
+	// Sprites reference regions of the imported sheet texture instead of one texture per cell
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bUseSheetAtlas = false;
+
+	// Multiply color by alpha while slicing, for materials that blend premultiplied
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bPremultiplyAlpha = false;
+
+	// Crop each frame to its visible pixels; the pivot still refers to the full cell
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bTrimFrames = true;
+
+	// Point cells with identical pixels at one sprite, within the sheet and across sheets of the same run
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bShareDuplicateFrames = true;
+
 	FSpriteSheetInfo()
 	{
 		Columns = 6;
 		Rows = 8;
 		SourceTexturePath = TEXT("/Game/RawAssets/");
 		DestinationPath = TEXT("/Game/Sprites/");
+		bUseSheetAtlas = false;
+		bPremultiplyAlpha = false;
+		bTrimFrames = true;
+		bShareDuplicateFrames = true;
 	}
 };
 
+/**
+ * CPU-side result of decoding and slicing a sprite sheet PNG.
+ * Holds no UObject references so it can be produced on a worker thread
+ * and handed to the game thread for asset creation.
+ */
+struct FDecodedSpriteSheet
+{
+	FString TextureName;
+	FString SourceFilePath;
+
+	int32 Width = 0;
+	int32 Height = 0;
+	int32 Columns = 0;
+	int32 Rows = 0;
+	int32 CellWidth = 0;
+	int32 CellHeight = 0;
+
+	// Full sheet in BGRA8. Moved into the sheet texture's source when assets are created,
+	// so it is empty afterwards.
+	TArray64<uint8> Pixels;
+
+	// One BGRA8 buffer per grid cell, row-major (Row * Columns + Col), holding only the CellBounds pixels
+	TArray<TArray<uint8>> Cells;
+
+	// Visible rectangle of each cell relative to the cell origin; the full cell when trimming is off
+	TArray<FIntRect> CellBounds;
+
+	// Content hash of each cell; shares duplicate sprites and merges held poses into one key frame
+	TArray<FSpriteFrameHash> CellHashes;
+
+	// Which cells become which flipbooks; resolved and validated while decoding
+	TSharedPtr<const FSpriteSheetLayout> Layout;
+
+	// MD5 of the PNG bytes, recorded in the incremental manifest
+	FString SourceHash;
+
+	bool bValid = false;
+
+	// The manifest says the outputs already match this PNG; nothing was decoded
+	bool bUpToDate = false;
+};
+
 UCLASS(BlueprintType, Blueprintable)
 class CHARACTERCREATIONCPP_API USpriteSheetProcessor : public UObject
 {
@@ -58,6 +113,9 @@ class CHARACTERCREATIONCPP_API USpriteSheetProcessor : public UObject
 public:
 	USpriteSheetProcessor();
 
+	// Bump whenever the generated assets change so the incremental manifest rebuilds every sheet
+	static constexpr int32 ProcessorVersion = 8;
+
 	UFUNCTION(BlueprintCallable, Category = "Sprite Processing")
 	bool ProcessSpriteSheet(const FString& TextureName, const FSpriteSheetInfo& SpriteInfo);
 
@@ -70,6 +128,7 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Sprite Processing")
 	TArray<UPaperSprite*> ExtractSprites(UTexture2D* Texture, const FSpriteSheetInfo& SpriteInfo);
 
+	// Uses RawAssets/<CharacterName>.layout.json when present, the warrior row layout otherwise
 	UFUNCTION(BlueprintCallable, Category = "Sprite Processing")
 	TArray<UPaperFlipbook*> CreateAnimations(const TArray<UPaperSprite*>& Sprites, const FSpriteSheetInfo& SpriteInfo, const FString& CharacterName = TEXT(""));
 
@@ -79,14 +138,79 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Input Creation")
 	UInputMappingContext* CreateInputMappingContext(const FString& ContextName, const FString& PackagePath, UInputAction* MoveAction, UInputAction* AttackAction);
 
+	// Decode and slice a PNG without touching UObjects. Safe to call from worker threads
+	// once PreloadDecoderModules() has run on the game thread.
+	static bool DecodeSpriteSheet(const FString& RawAssetPath, const FSpriteSheetInfo& SpriteInfo, FDecodedSpriteSheet& OutSheet);
+	static void PreloadDecoderModules();
+
+	// Game thread half of ProcessSpriteSheet: creates and saves assets from an already decoded sheet.
+	// Consumes DecodedSheet.Pixels.
+	bool ProcessDecodedSpriteSheet(const FString& TextureName, FDecodedSpriteSheet& DecodedSheet, const FSpriteSheetInfo& SpriteInfo);
+
+	// Palette swap: builds BaseTextureName once as an index sheet plus one palette texture per color,
+	// instead of a full sprite set per variant. Variants that are not pure recolors of the base are
+	// returned in OutFallbackVariants so the caller can process them as ordinary sheets.
+	UFUNCTION(BlueprintCallable, Category = "Sprite Processing")
+	bool ProcessPaletteVariants(const FString& BaseTextureName, const TArray<FString>& VariantTextureNames, const FSpriteSheetInfo& SpriteInfo, TArray<FString>& OutFallbackVariants);
+
+	// Package names of the sprites, their textures, the flipbooks and the animation set created by this processor
+	TArray<FString> GetGeneratedPackageNames() const;
+
+	// Share frames with every processor of a run. Without one, frames are only shared within a sheet.
+	void SetSharedFrameCache(FSpriteFrameCache* InFrameCache) { SharedFrameCache = InFrameCache; }
+
+	// Other sheets whose sprites the last processed sheet reuses
+	const TArray<FString>& GetBorrowedSheetNames() const { return BorrowedSheetNames; }
+
+	// Write the batched packages of a sheet with UPackage::SaveConcurrent instead of one by one
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sprite Processing")
+	bool bConcurrentSave = false;
+
 private:
-	FString GetAnimationName(EAnimationType AnimType, const FString& CharacterName = TEXT("")) const;
-	UTexture2D* CreateSpriteTexture(uint8* SourceData, int32 SourceWidth, int32 SourceHeight, 
-		int32 StartX, int32 StartY, int32 SpriteWidth, int32 SpriteHeight, int32 BytesPerPixel, const FString& SpriteName);
+	bool CreateSheetAssets(const FString& TextureName, FDecodedSpriteSheet& DecodedSheet, const FSpriteSheetInfo& SpriteInfo);
+
+	static bool DecodeImageFile(const FString& RawAssetPath, FDecodedSpriteSheet& OutSheet);
+	static bool SliceSpriteSheet(const FSpriteSheetInfo& SpriteInfo, FDecodedSpriteSheet& InOutSheet);
+
+	UTexture2D* CreateSheetTexture(FDecodedSpriteSheet& DecodedSheet, const FString& DestinationPath);
+	TArray<UPaperSprite*> ExtractSpritesFromDecoded(UTexture2D* SheetTexture, const FDecodedSpriteSheet& DecodedSheet, const FSpriteSheetInfo& SpriteInfo);
+	TArray<UPaperSprite*> ExtractAtlasSprites(UTexture2D* SheetTexture, int32 Columns, int32 Rows, int32 SpriteWidth, int32 SpriteHeight);
+
+	// TrimRect is the part of the SpriteWidth x SpriteHeight cell the texture region actually holds
+	UPaperSprite* CreateSprite(UTexture2D* SourceTexture, const FString& SpriteName, const FVector2D& SourceUV, int32 SpriteWidth, int32 SpriteHeight, const FIntRect& TrimRect);
+	void LogTrimSavings(const FString& TextureName, const FDecodedSpriteSheet& DecodedSheet, bool bUseSheetAtlas) const;
+	bool SaveSheetTexture(UTexture2D* SheetTexture);
+	UTexture2D* CreatePaletteTexture(const FString& VariantName, const TArray<FColor>& Colors);
+	bool CreatePaletteMaterialIfMissing(UTexture2D* DefaultSpriteTexture, UTexture2D* DefaultPalette);
+	bool CreateInputAssetsIfMissing();
+
+	// CellHashes may be empty, in which case only repeats of the same sprite are merged
+	TArray<UPaperFlipbook*> CreateLayoutAnimations(const TArray<UPaperSprite*>& Sprites, const TArray<FSpriteFrameHash>& CellHashes, int32 Columns, int32 Rows, const FSpriteSheetLayout& Layout, const FString& CharacterName);
+	FString GetAnimationName(const FString& BaseName, const FString& CharacterName = TEXT("")) const;
+
+	// AS_<Sheet> for the flipbooks whose layout name is an EAnimationType; null if none is
+	UWarriorAnimationSet* CreateAnimationSet(const FString& SheetName, const FSpriteSheetLayout& Layout, const TArray<UPaperFlipbook*>& Flipbooks);
+	UTexture2D* CreateSpriteTexture(const uint8* SourceData, int32 SourceWidth, int32 SourceHeight, 
+		int32 StartX, int32 StartY, int32 SpriteWidth, int32 SpriteHeight, ESpritePixelLayout SourceLayout, bool bPremultiplyAlpha, const FString& SpriteName);
 	
 	UPROPERTY(Transient, VisibleAnywhere, Category = "Generated Assets")
 	TArray<UPaperSprite*> GeneratedSprites;
 
 	UPROPERTY(Transient, VisibleAnywhere, Category = "Generated Assets")
 	TArray<UPaperFlipbook*> GeneratedFlipbooks;
+
+	UPROPERTY(Transient, VisibleAnywhere, Category = "Generated Assets")
+	UWarriorAnimationSet* GeneratedAnimationSet = nullptr;
+
+	// Every created asset goes through here; ProcessSpriteSheet opens a batch so a sheet is saved in one go
+	FSpritePackageSaveQueue SaveQueue;
+
+	// Set while an index sheet is written; its textures hold palette indices and must not be sRGB-decoded
+	bool bEncodingPaletteIndices = false;
+
+	FSpriteFrameCache& GetFrameCache() { return SharedFrameCache ? *SharedFrameCache : LocalFrameCache; }
+
+	FSpriteFrameCache LocalFrameCache;
+	FSpriteFrameCache* SharedFrameCache = nullptr;
+	TArray<FString> BorrowedSheetNames;
 };
\ No newline at end of file
@@ -0,0 +1,18 @@
+#include "WarriorAnimationSet.h"
+#include "PaperFlipbook.h"
+
+FString UWarriorAnimationSet::GetAssetPath(const FString& SheetName)
+{
+	return FString::Printf(TEXT("/Game/Animations/%s"), *GetAssetName(SheetName));
+}
+
+bool UWarriorAnimationSet::IsLooping(EAnimationType Type) const
+{
+	const bool* bLooping = Looping.Find(Type);
+	return bLooping ? *bLooping : IsLoopingByDefault(Type);
+}
+
+FString UWarriorAnimationSet::GetAssetName(const FString& SheetName)
+{
+	return TEXT("AS_") + SheetName;
+}
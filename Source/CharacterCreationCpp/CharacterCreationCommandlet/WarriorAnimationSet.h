@@ -0,0 +1,51 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "WarriorAnimationSet.generated.h"
+
+class UPaperFlipbook;
+
+UENUM(BlueprintType)
+enum class EAnimationType : uint8
+{
+	Idle = 0,
+	Move = 1,
+	AttackSideways = 2,
+	AttackSideways2 = 3,
+	AttackDownwards = 4,
+	AttackDownwards2 = 5,
+	AttackUpwards = 6,
+	AttackUpwards2 = 7
+};
+
+// Size of a table indexed by EAnimationType
+constexpr int32 NumAnimationTypes = static_cast<int32>(EAnimationType::AttackUpwards2) + 1;
+
+/**
+ * The flipbooks of one character, keyed by animation type.
+ *
+ * The sprite commandlet writes one per sheet (/Game/Animations/AS_<Sheet>) next to the flipbooks it
+ * creates, so characters pick up a new animation set without code changes.
+ */
+UCLASS(BlueprintType)
+class CHARACTERCREATIONCPP_API UWarriorAnimationSet : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Animations")
+	TMap<EAnimationType, TObjectPtr<UPaperFlipbook>> Animations;
+
+	// The sheet layout's Loop flag per animation; sets saved before it existed have none
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Animations")
+	TMap<EAnimationType, bool> Looping;
+
+	bool IsLooping(EAnimationType Type) const;
+
+	// Idle and move loop, attacks play once
+	static bool IsLoopingByDefault(EAnimationType Type) { return Type < EAnimationType::AttackSideways; }
+
+	static FString GetAssetPath(const FString& SheetName);
+	static FString GetAssetName(const FString& SheetName);
+};
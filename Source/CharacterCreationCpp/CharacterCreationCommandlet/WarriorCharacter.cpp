@@ -2,22 +2,110 @@
 #include "Components/CapsuleComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "PaperFlipbookComponent.h"
-#include "Engine/Engine.h"
 #include "TimerManager.h"
 #include "HAL/IConsoleManager.h"
+#include "SpritePalette.h"
+#include "Algo/Count.h"
+#include "Stats/Stats.h"
+#include "Misc/PackageName.h"
+#include "UObject/GCObject.h"
+
+// Per-frame counts of the sprite component updates warriors actually make ("stat Warrior")
+DECLARE_STATS_GROUP(TEXT("Warrior"), STATGROUP_Warrior, STATCAT_Advanced);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Flipbook Transitions"), STAT_WarriorFlipbookTransitions, STATGROUP_Warrior);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Facing Flips"), STAT_WarriorFacingFlips, STATGROUP_Warrior);
+
+namespace
+{
+    // What every warrior of one class starts with, so soft references are resolved once per class
+    struct FWarriorClassAssets
+    {
+        TArray<TObjectPtr<UPaperFlipbook>> Animations;
+        TArray<bool> Looping;
+        TObjectPtr<UTexture2D> PaletteTexture;
+        TObjectPtr<UMaterialInterface> PaletteMaterial;
+    };
+
+    class FWarriorClassAssetCache : public FGCObject
+    {
+    public:
+        TMap<TObjectKey<UClass>, FWarriorClassAssets> Classes;
+
+        virtual void AddReferencedObjects(FReferenceCollector& Collector) override
+        {
+            for (TPair<TObjectKey<UClass>, FWarriorClassAssets>& Entry : Classes)
+            {
+                Collector.AddReferencedObjects(Entry.Value.Animations);
+                Collector.AddReferencedObject(Entry.Value.PaletteTexture);
+                Collector.AddReferencedObject(Entry.Value.PaletteMaterial);
+            }
+        }
+
+        virtual FString GetReferencerName() const override
+        {
+            return TEXT("FWarriorClassAssetCache");
+        }
+    };
+
+    FWarriorClassAssetCache& GetClassAssetCache()
+    {
+        static FWarriorClassAssetCache Cache;
+        return Cache;
+    }
+
+    // "/Game/Foo/Bar" names the asset "/Game/Foo/Bar.Bar"
+    FSoftObjectPath MakeAssetPath(const FString& PackagePath)
+    {
+        return FSoftObjectPath(PackagePath + TEXT(".") + FPackageName::GetShortName(PackagePath));
+    }
+
+    bool DoesAssetExist(const FSoftObjectPath& Path)
+    {
+        return !Path.IsNull() && FPackageName::DoesPackageExist(Path.GetLongPackageName());
+    }
+
+    template <typename AssetType>
+    AssetType* ResolveSoft(const TSoftObjectPtr<AssetType>& Reference, bool bAllowSyncLoad)
+    {
+        AssetType* Asset = Reference.Get();
+        if (!Asset && bAllowSyncLoad && DoesAssetExist(Reference.ToSoftObjectPath()))
+        {
+            Asset = Reference.LoadSynchronous();
+        }
+        return Asset;
+    }
+}
 
 AWarriorCharacter::AWarriorCharacter()
 {
     PrimaryActorTick.bCanEverTick = true;
 
+    // Event-driven by default: input and the attack timer wake the tick when there is something to apply
+    bEventDrivenAnimation = true;
+    PrimaryActorTick.bStartWithTickEnabled = false;
+
     // Set default values
     MovementSpeed = 300.0f;
     JumpVelocity = 400.0f;
     bIsMoving = false;
     bIsAttacking = false;
     bFacingRight = true;
+    bSpriteFacingRight = true;
+    bComboQueued = false;
+    CurrentAnimation = EAnimationType::Idle;
+    AttackStartTime = 0.0f;
+    ComboWindow = 0.35f;
     CurrentMoveRightValue = 0.0f;
     CurrentMoveUpValue = 0.0f;
+    PaletteTexture = nullptr;
+    PaletteMaterial = nullptr;
+    PaletteMaterialInstance = nullptr;
+    Animations.Init(nullptr, NumAnimationTypes);
+    AnimationLooping.SetNum(NumAnimationTypes);
+    for (int32 Index = 0; Index < NumAnimationTypes; Index++)
+    {
+        AnimationLooping[Index] = UWarriorAnimationSet::IsLoopingByDefault(static_cast<EAnimationType>(Index));
+    }
 
     // Configure character movement
     GetCharacterMovement()->MaxWalkSpeed = MovementSpeed;
@@ -37,7 +125,7 @@ AWarriorCharacter::AWarriorCharacter()
 
     // Get sprite component reference
     SpriteComponent = GetSprite();
-    UE_LOG(LogCharacterCreation, Warning, TEXT("=== %s CONSTRUCTOR: SpriteComponent = %s ==="), 
+    UE_LOG(LogCharacterCreation, Verbose, TEXT("%s constructor: SpriteComponent = %s"), 
         *GetClass()->GetName(), SpriteComponent ? TEXT("VALID") : TEXT("NULL"));
     
     if (SpriteComponent)
@@ -46,64 +134,19 @@ AWarriorCharacter::AWarriorCharacter()
         // Offset sprite down so feet align with capsule bottom
         // Capsule half-height is 20, so offset sprite down by ~16 units to align feet
         SpriteComponent->SetRelativeLocation(FVector(0.0f, 0.0f, -16.0f));
-        
-        // Try loading animations right here in constructor for the specific derived class
-        // This is a workaround for virtual functions not working in constructors
-        FString ClassName = GetClass()->GetName();
-        if (ClassName.Contains(TEXT("Purple")))
-        {
-            UE_LOG(LogCharacterCreation, Warning, TEXT("Loading Purple animations in constructor"));
-            UPaperFlipbook* TempIdle = LoadObject<UPaperFlipbook>(nullptr, TEXT("/Game/Animations/Idle_Warrior_Purple"));
-            if (TempIdle)
-            {
-                SpriteComponent->SetFlipbook(TempIdle);
-                UE_LOG(LogCharacterCreation, Warning, TEXT("✓✓✓ Set Purple idle animation in CONSTRUCTOR ✓✓✓"));
-            }
-        }
-        else if (ClassName.Contains(TEXT("Blue")))
-        {
-            UE_LOG(LogCharacterCreation, Warning, TEXT("Loading Blue animations in constructor"));
-            UPaperFlipbook* TempIdle = LoadObject<UPaperFlipbook>(nullptr, TEXT("/Game/Animations/Idle_Warrior_Blue"));
-            if (TempIdle)
-            {
-                SpriteComponent->SetFlipbook(TempIdle);
-                UE_LOG(LogCharacterCreation, Warning, TEXT("✓✓✓ Set Blue idle animation in CONSTRUCTOR ✓✓✓"));
-            }
-        }
-        else if (ClassName.Contains(TEXT("Red")))
-        {
-            UE_LOG(LogCharacterCreation, Warning, TEXT("Loading Red animations in constructor"));
-            UPaperFlipbook* TempIdle = LoadObject<UPaperFlipbook>(nullptr, TEXT("/Game/Animations/Idle_Warrior_Red"));
-            if (TempIdle)
-            {
-                SpriteComponent->SetFlipbook(TempIdle);
-                UE_LOG(LogCharacterCreation, Warning, TEXT("✓✓✓ Set Red idle animation in CONSTRUCTOR ✓✓✓"));
-            }
-        }
     }
     else
     {
         UE_LOG(LogCharacterCreation, Error, TEXT("SpriteComponent is NULL in constructor!"));
     }
 
-    // Create SpringArm component
-    SpringArmComponent = CreateDefaultSubobject<USpringArmComponent>(TEXT("SpringArmComponent"));
-    SpringArmComponent->SetupAttachment(RootComponent);
-    SpringArmComponent->TargetArmLength = 200.0f;
-    SpringArmComponent->SetWorldRotation(FRotator(0.0f, -90.0f, 0.0f)); // Side view angle
-    SpringArmComponent->bDoCollisionTest = false;
-    SpringArmComponent->bInheritPitch = false;
-    SpringArmComponent->bInheritYaw = false;
-    SpringArmComponent->bInheritRoll = false;
-
-    // Create Camera component
-    CameraComponent = CreateDefaultSubobject<UCameraComponent>(TEXT("CameraComponent"));
-    CameraComponent->SetupAttachment(SpringArmComponent, USpringArmComponent::SocketName);
-    CameraComponent->SetProjectionMode(ECameraProjectionMode::Perspective);
-    CameraComponent->SetFieldOfView(90.0f);
+    // Camera components are created on demand for locally controlled warriors (see UpdatePlayerCamera)
+    SpringArmComponent = nullptr;
+    CameraComponent = nullptr;
+    bCreatePlayerCamera = true;
 
-    // Set default input assets as UPROPERTY values for Blueprint editor
-    TryLoadInputAssetsForEditor();
+    // Only paths here; constructing a warrior or its CDO never loads an asset
+    DeclareInputAssets();
 }
 
 void AWarriorCharacter::PostInitializeComponents()
@@ -111,7 +154,7 @@ void AWarriorCharacter::PostInitializeComponents()
     Super::PostInitializeComponents();
     
     // Load animations after object is fully constructed - virtual functions work correctly now
-    UE_LOG(LogCharacterCreation, Warning, TEXT("=== %s::PostInitializeComponents() CALLED ==="), *GetClass()->GetName());
+    UE_LOG(LogCharacterCreation, Verbose, TEXT("%s::PostInitializeComponents"), *GetClass()->GetName());
     
     // Verify sprite component exists
     if (!SpriteComponent)
@@ -120,34 +163,48 @@ void AWarriorCharacter::PostInitializeComponents()
         return;
     }
     
-    UE_LOG(LogCharacterCreation, Warning, TEXT("Calling LoadAnimations() for %s"), *GetClass()->GetName());
+    UE_LOG(LogCharacterCreation, Verbose, TEXT("Calling LoadAnimations() for %s"), *GetClass()->GetName());
+    // Blueprint defaults saved before the table existed may hold fewer entries
+    Animations.SetNum(NumAnimationTypes);
     LoadAnimations();
     
     // Count successful loads
     int32 LoadedCount = 0;
-    if (IdleAnimation) LoadedCount++;
-    if (MoveAnimation) LoadedCount++;
-    if (AttackUpAnimation) LoadedCount++;
-    if (AttackDownAnimation) LoadedCount++;
-    if (AttackSideAnimation) LoadedCount++;
-    if (AttackUp2Animation) LoadedCount++;
-    if (AttackDown2Animation) LoadedCount++;
-    if (AttackSide2Animation) LoadedCount++;
+    for (const UPaperFlipbook* Animation : Animations)
+    {
+        LoadedCount += Animation ? 1 : 0;
+    }
     
-    UE_LOG(LogCharacterCreation, Warning, TEXT("PostInitializeComponents loaded %d/8 animations"), LoadedCount);
+    UE_LOG(LogCharacterCreation, Verbose, TEXT("PostInitializeComponents loaded %d/%d animations"), LoadedCount, NumAnimationTypes);
+
+    ApplyPalette();
     
-    // Don't set the flipbook here - let the derived class do it in LoadAnimations()
-    // This avoids conflicts between base and derived class both trying to set it
-    if (!IdleAnimation)
+    if (!GetAnimation(EAnimationType::Idle))
     {
         UE_LOG(LogCharacterCreation, Error, TEXT("No IdleAnimation loaded for %s!"), *GetClass()->GetName());
     }
+    else
+    {
+        PlayAnimation(EAnimationType::Idle);
+    }
 }
 
 void AWarriorCharacter::BeginPlay()
 {
     Super::BeginPlay();
+
+    // Polling mode ticks every frame; event-driven mode ticks once to settle the initial state
+    if (bEventDrivenAnimation)
+    {
+        RequestAnimationUpdate();
+    }
+    else
+    {
+        SetActorTickEnabled(true);
+    }
     
+    LoadInputAssets();
+
     // Setup Enhanced Input
     APlayerController* PlayerController = Cast<APlayerController>(GetController());
     if (PlayerController)
@@ -155,44 +212,36 @@ void AWarriorCharacter::BeginPlay()
         UEnhancedInputLocalPlayerSubsystem* Subsystem = ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(PlayerController->GetLocalPlayer());
         if (Subsystem)
         {
-            // Use DefaultMappingContext that was loaded in constructor (if available)
-            if (DefaultMappingContext)
+            if (UInputMappingContext* MappingContext = DefaultMappingContext.Get())
             {
-                Subsystem->AddMappingContext(DefaultMappingContext, 0);
-                UE_LOG(LogCharacterCreation, Verbose, TEXT("✓ Added Input Mapping Context: IMC_PlayerInput"));
+                Subsystem->AddMappingContext(MappingContext, 0);
+                UE_LOG(LogCharacterCreation, Verbose, TEXT("Added Input Mapping Context: IMC_PlayerInput"));
             }
             else
             {
-                UE_LOG(LogCharacterCreation, Verbose, TEXT("✗ DefaultMappingContext is null - not loaded in constructor"));
+                UE_LOG(LogCharacterCreation, Verbose, TEXT("DefaultMappingContext could not be loaded"));
             }
         }
     }
 
-    // Input actions should already be loaded in constructor, log their status
     UE_LOG(LogCharacterCreation, Verbose, TEXT("BeginPlay - Input Actions Status:"));
-    UE_LOG(LogCharacterCreation, Verbose, TEXT("MoveAction: %s"), MoveAction ? TEXT("YES") : TEXT("NO"));
-    UE_LOG(LogCharacterCreation, Verbose, TEXT("AttackAction: %s"), AttackAction ? TEXT("YES") : TEXT("NO"));
+    UE_LOG(LogCharacterCreation, Verbose, TEXT("MoveAction: %s"), MoveAction.Get() ? TEXT("YES") : TEXT("NO"));
+    UE_LOG(LogCharacterCreation, Verbose, TEXT("AttackAction: %s"), AttackAction.Get() ? TEXT("YES") : TEXT("NO"));
     
     // Animations should already be loaded in PostInitializeComponents
-    UE_LOG(LogCharacterCreation, Verbose, TEXT("BeginPlay - Animations already loaded in PostInitializeComponents (%d/8)"), 
-        (IdleAnimation ? 1 : 0) + (MoveAnimation ? 1 : 0) + (AttackUpAnimation ? 1 : 0) + 
-        (AttackDownAnimation ? 1 : 0) + (AttackSideAnimation ? 1 : 0) + (AttackUp2Animation ? 1 : 0) + 
-        (AttackDown2Animation ? 1 : 0) + (AttackSide2Animation ? 1 : 0));
-    
-    // Load input assets if not already set via Blueprint
-    if (!DefaultMappingContext || !MoveAction || !AttackAction)
-    {
-        LoadInputAssets();
-    }
+    UE_LOG(LogCharacterCreation, Verbose, TEXT("BeginPlay - Animations already loaded in PostInitializeComponents (%d/%d)"), 
+        Animations.Num() - Algo::Count(Animations, nullptr), NumAnimationTypes);
+
     
     // Animation should already be set in PostInitializeComponents, just verify
+    UPaperFlipbook* IdleAnimation = GetAnimation(EAnimationType::Idle);
     if (SpriteComponent && IdleAnimation)
     {
-        UE_LOG(LogCharacterCreation, Verbose, TEXT("✓ Animation already set in PostInitializeComponents"));
+        UE_LOG(LogCharacterCreation, Verbose, TEXT("Animation already set in PostInitializeComponents"));
     }
     else
     {
-        UE_LOG(LogCharacterCreation, Warning, TEXT("⚠️ Animation not properly set - SpriteComponent: %s, IdleAnimation: %s"), 
+        UE_LOG(LogCharacterCreation, Warning, TEXT("Animation not properly set - SpriteComponent: %s, IdleAnimation: %s"), 
             SpriteComponent ? TEXT("Valid") : TEXT("NULL"),
             IdleAnimation ? TEXT("Valid") : TEXT("NULL"));
     }
@@ -200,11 +249,201 @@ void AWarriorCharacter::BeginPlay()
 
 void AWarriorCharacter::LoadAnimations()
 {
-    // Base implementation - derived classes should override this to load their specific animations
-    UE_LOG(LogCharacterCreation, Error, TEXT("=== BASE CLASS LoadAnimations() called - This should NOT happen! Derived class override should be called instead! ==="));
-    
-    // This is intentionally empty - derived classes like WarriorPurpleCharacter, WarriorBlueCharacter, etc.
-    // will override this method to load their character-specific animations
+    // Normally resolved once the game mode's preload finished; a warrior spawned before that, or in
+    // the editor, resolves its class here and pays for the loads
+    if (!AreClassAssetsResolved(GetClass()))
+    {
+        ResolveClassAssets(GetClass(), true);
+    }
+
+    const FWarriorClassAssets& ClassAssets = GetClassAssetCache().Classes.FindChecked(GetClass());
+    for (int32 Index = 0; Index < NumAnimationTypes; Index++)
+    {
+        if (ClassAssets.Animations[Index])
+        {
+            Animations[Index] = ClassAssets.Animations[Index];
+            AnimationLooping[Index] = ClassAssets.Looping[Index];
+        }
+    }
+
+    if (ClassAssets.PaletteTexture && ClassAssets.PaletteMaterial)
+    {
+        PaletteTexture = ClassAssets.PaletteTexture;
+        PaletteMaterial = ClassAssets.PaletteMaterial;
+
+        // The material's default palette is the base one; the instance created in ApplyPalette picks the variant
+        if (SpriteComponent)
+        {
+            SpriteComponent->SetMaterial(0, PaletteMaterial);
+        }
+    }
+}
+
+void AWarriorCharacter::DeclareAnimationAssets(const FString& SheetName, const FString& PaletteBaseName)
+{
+    AnimationSet = MakeAssetPath(UWarriorAnimationSet::GetAssetPath(SheetName));
+
+    if (!PaletteBaseName.IsEmpty())
+    {
+        PaletteAnimationSet = MakeAssetPath(UWarriorAnimationSet::GetAssetPath(FSpritePalette::GetIndexedSheetName(PaletteBaseName)));
+        DefaultPalette = MakeAssetPath(FSpritePalette::GetPaletteTexturePath(SheetName));
+        DefaultPaletteMaterial = MakeAssetPath(FSpritePalette::MaterialPath);
+    }
+}
+
+void AWarriorCharacter::GetPreloadPaths(TSubclassOf<AWarriorCharacter> Class, TArray<FSoftObjectPath>& OutPaths)
+{
+    const AWarriorCharacter* Defaults = Class ? Class->GetDefaultObject<AWarriorCharacter>() : nullptr;
+    if (!Defaults)
+    {
+        return;
+    }
+
+    const FSoftObjectPath Paths[] = {
+        Defaults->AnimationSet.ToSoftObjectPath(),
+        Defaults->PaletteAnimationSet.ToSoftObjectPath(),
+        Defaults->DefaultPalette.ToSoftObjectPath(),
+        Defaults->DefaultPaletteMaterial.ToSoftObjectPath(),
+        Defaults->DefaultMappingContext.ToSoftObjectPath(),
+        Defaults->MoveAction.ToSoftObjectPath(),
+        Defaults->AttackAction.ToSoftObjectPath()
+    };
+
+    for (const FSoftObjectPath& Path : Paths)
+    {
+        if (DoesAssetExist(Path))
+        {
+            OutPaths.AddUnique(Path);
+        }
+    }
+}
+
+bool AWarriorCharacter::AreClassAssetsResolved(TSubclassOf<AWarriorCharacter> Class)
+{
+    return GetClassAssetCache().Classes.Contains(Class.Get());
+}
+
+void AWarriorCharacter::ResolveClassAssets(TSubclassOf<AWarriorCharacter> Class, bool bAllowSyncLoad)
+{
+    const AWarriorCharacter* Defaults = Class ? Class->GetDefaultObject<AWarriorCharacter>() : nullptr;
+    if (!Defaults)
+    {
+        return;
+    }
+
+    if (bAllowSyncLoad)
+    {
+        // Only a running game preloads; the editor and commandlets always resolve on demand
+        if (!GIsEditor && !IsRunningCommandlet())
+        {
+            UE_LOG(LogCharacterCreation, Warning, TEXT("%s assets were not preloaded, loading them synchronously"), *Class->GetName());
+        }
+        else
+        {
+            UE_LOG(LogCharacterCreation, Verbose, TEXT("Loading %s assets synchronously"), *Class->GetName());
+        }
+    }
+
+    FWarriorClassAssets ClassAssets;
+    ClassAssets.Animations.Init(nullptr, NumAnimationTypes);
+    ClassAssets.Looping.SetNum(NumAnimationTypes);
+
+    // The palette animations only make sense together with a palette and its material
+    UWarriorAnimationSet* ResolvedPaletteSet = ResolveSoft(Defaults->PaletteAnimationSet, bAllowSyncLoad);
+    UTexture2D* ResolvedPalette = ResolvedPaletteSet ? ResolveSoft(Defaults->DefaultPalette, bAllowSyncLoad) : nullptr;
+    UMaterialInterface* ResolvedMaterial = ResolvedPalette ? ResolveSoft(Defaults->DefaultPaletteMaterial, bAllowSyncLoad) : nullptr;
+
+    const UWarriorAnimationSet* ResolvedSet = nullptr;
+    if (ResolvedPaletteSet && ResolvedPalette && ResolvedMaterial)
+    {
+        ResolvedSet = ResolvedPaletteSet;
+        ClassAssets.PaletteTexture = ResolvedPalette;
+        ClassAssets.PaletteMaterial = ResolvedMaterial;
+    }
+    else
+    {
+        ResolvedSet = ResolveSoft(Defaults->AnimationSet, bAllowSyncLoad);
+    }
+
+    if (ResolvedSet)
+    {
+        for (const TPair<EAnimationType, TObjectPtr<UPaperFlipbook>>& Entry : ResolvedSet->Animations)
+        {
+            ClassAssets.Animations[static_cast<int32>(Entry.Key)] = Entry.Value;
+        }
+    }
+
+    for (int32 Index = 0; Index < NumAnimationTypes; Index++)
+    {
+        const EAnimationType Type = static_cast<EAnimationType>(Index);
+        ClassAssets.Looping[Index] = ResolvedSet ? ResolvedSet->IsLooping(Type) : UWarriorAnimationSet::IsLoopingByDefault(Type);
+    }
+
+    UE_LOG(LogCharacterCreation, Log, TEXT("Resolved %s: %s, %d/%d animations"), *Class->GetName(),
+        ResolvedSet ? *ResolvedSet->GetName() : TEXT("no animation set"),
+        NumAnimationTypes - Algo::Count(ClassAssets.Animations, nullptr), NumAnimationTypes);
+
+    GetClassAssetCache().Classes.Add(Class.Get(), MoveTemp(ClassAssets));
+}
+
+void AWarriorCharacter::GetClassAssets(TSubclassOf<AWarriorCharacter> Class, TArray<UPaperFlipbook*>& OutAnimations,
+    TArray<bool>& OutLooping, UTexture2D*& OutPaletteTexture, UMaterialInterface*& OutPaletteMaterial)
+{
+    OutAnimations.Init(nullptr, NumAnimationTypes);
+    OutLooping.Init(false, NumAnimationTypes);
+    OutPaletteTexture = nullptr;
+    OutPaletteMaterial = nullptr;
+
+    if (!Class)
+    {
+        return;
+    }
+
+    if (!AreClassAssetsResolved(Class))
+    {
+        ResolveClassAssets(Class, true);
+    }
+
+    const FWarriorClassAssets& ClassAssets = GetClassAssetCache().Classes.FindChecked(Class.Get());
+    for (int32 Index = 0; Index < NumAnimationTypes; Index++)
+    {
+        OutAnimations[Index] = ClassAssets.Animations[Index];
+        OutLooping[Index] = ClassAssets.Looping[Index];
+    }
+    OutPaletteTexture = ClassAssets.PaletteTexture;
+    OutPaletteMaterial = ClassAssets.PaletteMaterial;
+}
+
+void AWarriorCharacter::AssignAnimation(EAnimationType Type, UPaperFlipbook* Animation)
+{
+    if (Animations.IsValidIndex(static_cast<int32>(Type)))
+    {
+        Animations[static_cast<int32>(Type)] = Animation;
+    }
+}
+
+void AWarriorCharacter::ApplyPalette()
+{
+    if (!SpriteComponent || !PaletteMaterial || !PaletteTexture)
+    {
+        return;
+    }
+
+    if (!PaletteMaterialInstance)
+    {
+        PaletteMaterialInstance = SpriteComponent->CreateDynamicMaterialInstance(0, PaletteMaterial);
+    }
+
+    if (PaletteMaterialInstance)
+    {
+        PaletteMaterialInstance->SetTextureParameterValue(FSpritePalette::ParameterName, PaletteTexture);
+    }
+}
+
+void AWarriorCharacter::SetPalette(UTexture2D* NewPalette)
+{
+    PaletteTexture = NewPalette;
+    ApplyPalette();
 }
 
 void AWarriorCharacter::LoadAndAssignAnimations()
@@ -213,6 +452,139 @@ void AWarriorCharacter::LoadAndAssignAnimations()
     LoadAnimations();
 }
 
+void AWarriorCharacter::NotifyControllerChanged()
+{
+    Super::NotifyControllerChanged();
+
+    UpdatePlayerCamera();
+}
+
+void AWarriorCharacter::UpdatePlayerCamera()
+{
+    const bool bWantsCamera = bCreatePlayerCamera && IsLocallyControlled() && IsPlayerControlled();
+    if (bWantsCamera == (CameraComponent != nullptr))
+    {
+        return;
+    }
+
+    if (!bWantsCamera)
+    {
+        CameraComponent->DestroyComponent();
+        SpringArmComponent->DestroyComponent();
+        CameraComponent = nullptr;
+        SpringArmComponent = nullptr;
+        return;
+    }
+
+    // Unnamed, since a destroyed rig keeps its name until garbage collection
+    SpringArmComponent = NewObject<USpringArmComponent>(this);
+    SpringArmComponent->SetupAttachment(RootComponent);
+    SpringArmComponent->TargetArmLength = 200.0f;
+    SpringArmComponent->SetRelativeRotation(FRotator(0.0f, -90.0f, 0.0f)); // Side view angle
+    SpringArmComponent->bDoCollisionTest = false;
+    SpringArmComponent->bInheritPitch = false;
+    SpringArmComponent->bInheritYaw = false;
+    SpringArmComponent->bInheritRoll = false;
+    SpringArmComponent->RegisterComponent();
+
+    CameraComponent = NewObject<UCameraComponent>(this);
+    CameraComponent->SetupAttachment(SpringArmComponent, USpringArmComponent::SocketName);
+    CameraComponent->SetProjectionMode(ECameraProjectionMode::Perspective);
+    CameraComponent->SetFieldOfView(90.0f);
+    CameraComponent->RegisterComponent();
+}
+
+void AWarriorCharacter::DeactivateForPool()
+{
+    bIsPooled = true;
+
+    GetWorldTimerManager().ClearTimer(AttackTimerHandle);
+
+    // AI controllers belong to this warrior and wait for it in the pool; a player keeps its controller for the next pawn
+    if (AController* OwningController = GetController())
+    {
+        OwningController->UnPossess();
+        if (!OwningController->IsPlayerController())
+        {
+            PooledController = OwningController;
+        }
+    }
+
+    // A hidden flipbook would otherwise keep advancing every frame
+    if (SpriteComponent)
+    {
+        SpriteComponent->Stop();
+        SpriteComponent->SetComponentTickEnabled(false);
+    }
+
+    GetCharacterMovement()->StopMovementImmediately();
+    GetCharacterMovement()->Deactivate();
+    SetActorTickEnabled(false);
+    SetActorEnableCollision(false);
+    SetActorHiddenInGame(true);
+}
+
+void AWarriorCharacter::Destroyed()
+{
+    // A warrior destroyed while pooled takes its waiting controller with it
+    if (IsValid(PooledController))
+    {
+        PooledController->Destroy();
+    }
+    PooledController = nullptr;
+
+    Super::Destroyed();
+}
+
+void AWarriorCharacter::ReactivateFromPool(const FTransform& SpawnTransform)
+{
+    bIsPooled = false;
+
+    // Reset everything a fresh spawn would start with
+    CurrentMoveRightValue = 0.0f;
+    CurrentMoveUpValue = 0.0f;
+    bIsMoving = false;
+    bIsAttacking = false;
+    bComboQueued = false;
+    AttackStartTime = 0.0f;
+    bFacingRight = true;
+    GetWorldTimerManager().ClearTimer(AttackTimerHandle);
+
+    SetActorTransform(SpawnTransform, false, nullptr, ETeleportType::ResetPhysics);
+    SetActorHiddenInGame(false);
+    SetActorEnableCollision(true);
+    GetCharacterMovement()->Activate(true);
+
+    // Restart the idle clip even when it is still on the component from before
+    if (SpriteComponent)
+    {
+        SpriteComponent->SetComponentTickEnabled(true);
+        SpriteComponent->SetFlipbook(nullptr);
+    }
+    CurrentAnimation = EAnimationType::Idle;
+    PlayAnimation(EAnimationType::Idle);
+    UpdateSpriteDirection();
+
+    if (IsValid(PooledController) && !PooledController->GetPawn())
+    {
+        PooledController->Possess(this);
+    }
+    else if (!GetController() && (AutoPossessAI == EAutoPossessAI::Spawned || AutoPossessAI == EAutoPossessAI::PlacedInWorldOrSpawned))
+    {
+        SpawnDefaultController();
+    }
+    PooledController = nullptr;
+
+    if (bEventDrivenAnimation)
+    {
+        RequestAnimationUpdate();
+    }
+    else
+    {
+        SetActorTickEnabled(true);
+    }
+}
+
 void AWarriorCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
 {
     Super::SetupPlayerInputComponent(PlayerInputComponent);
@@ -220,27 +592,30 @@ void AWarriorCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputCo
     // Cast to Enhanced Input Component
     UEnhancedInputComponent* EnhancedInputComponent = CastChecked<UEnhancedInputComponent>(PlayerInputComponent);
 
+    // Possession can come before BeginPlay, so the input assets may not be resolved yet
+    LoadInputAssets();
+
     // Bind Move Action (WASD)
-    if (MoveAction)
+    if (UInputAction* LoadedMoveAction = MoveAction.Get())
     {
-        EnhancedInputComponent->BindAction(MoveAction, ETriggerEvent::Triggered, this, &AWarriorCharacter::Move);
-        EnhancedInputComponent->BindAction(MoveAction, ETriggerEvent::Completed, this, &AWarriorCharacter::StopMove);
-        UE_LOG(LogCharacterCreation, Verbose, TEXT("✓ Bound Move Action"));
+        EnhancedInputComponent->BindAction(LoadedMoveAction, ETriggerEvent::Triggered, this, &AWarriorCharacter::Move);
+        EnhancedInputComponent->BindAction(LoadedMoveAction, ETriggerEvent::Completed, this, &AWarriorCharacter::StopMove);
+        UE_LOG(LogCharacterCreation, Verbose, TEXT("Bound Move Action"));
     }
     else
     {
-        UE_LOG(LogCharacterCreation, Verbose, TEXT("✗ MoveAction is null, cannot bind"));
+        UE_LOG(LogCharacterCreation, Verbose, TEXT("MoveAction is null, cannot bind"));
     }
 
     // Bind Attack Action (Left Mouse)
-    if (AttackAction)
+    if (UInputAction* LoadedAttackAction = AttackAction.Get())
     {
-        EnhancedInputComponent->BindAction(AttackAction, ETriggerEvent::Started, this, &AWarriorCharacter::Attack);
-        UE_LOG(LogCharacterCreation, Verbose, TEXT("✓ Bound Attack Action"));
+        EnhancedInputComponent->BindAction(LoadedAttackAction, ETriggerEvent::Started, this, &AWarriorCharacter::Attack);
+        UE_LOG(LogCharacterCreation, Verbose, TEXT("Bound Attack Action"));
     }
     else
     {
-        UE_LOG(LogCharacterCreation, Verbose, TEXT("✗ AttackAction is null, cannot bind"));
+        UE_LOG(LogCharacterCreation, Verbose, TEXT("AttackAction is null, cannot bind"));
     }
 }
 
@@ -252,7 +627,8 @@ void AWarriorCharacter::Move(const FInputActionValue& Value)
     CurrentMoveRightValue = MovementVector.X;
     CurrentMoveUpValue = MovementVector.Y;
     
-    UE_LOG(LogCharacterCreation, Log, TEXT("Move called with value: (%f, %f)"), MovementVector.X, MovementVector.Y);
+    // Fires on every input trigger while the stick or key is held
+    UE_LOG_CHARACTER_CREATION_THROTTLED(VeryVerbose, 1.0, TEXT("Move called with value: (%.2f, %.2f)"), MovementVector.X, MovementVector.Y);
     
     if (FMath::Abs(MovementVector.X) > 0.1f)
     {
@@ -276,6 +652,8 @@ void AWarriorCharacter::Move(const FInputActionValue& Value)
         // Negate the Y value to fix inverted controls (W should go up/forward, S should go down/back)
         AddMovementInput(FVector(0, 1, 0), -MovementVector.Y);
     }
+
+    RequestAnimationUpdate();
 }
 
 void AWarriorCharacter::StopMove(const FInputActionValue& Value)
@@ -284,25 +662,78 @@ void AWarriorCharacter::StopMove(const FInputActionValue& Value)
     CurrentMoveRightValue = 0.0f;
     CurrentMoveUpValue = 0.0f;
     
-    UE_LOG(LogCharacterCreation, Verbose, TEXT("StopMove called - movement values reset to 0"));
+    UE_LOG(LogCharacterCreation, VeryVerbose, TEXT("StopMove called - movement values reset to 0"));
+
+    RequestAnimationUpdate();
 }
 
 void AWarriorCharacter::Attack(const FInputActionValue& Value)
 {
-    if (!bIsAttacking && AttackSideAnimation)
+    if (!bIsAttacking)
     {
-        bIsAttacking = true;
-        SetAnimation(AttackSideAnimation);
-        
-        // Set timer to end attack
-        GetWorldTimerManager().SetTimer(AttackTimerHandle, this, &AWarriorCharacter::EndAttack, 0.5f, false);
-        
-        UE_LOG(LogCharacterCreation, Verbose, TEXT("Attack performed!"));
-        
-        if (GEngine)
-        {
-            GEngine->AddOnScreenDebugMessage(-1, 1.0f, FColor::Red, TEXT("Attack!"));
-        }
+        StartAttack(GetAttackForInput());
+        return;
+    }
+
+    // Pressing again early in a first swing chains the second swing of the same direction
+    const EAnimationType FollowUp = GetComboFollowUp(CurrentAnimation);
+    if (FollowUp != CurrentAnimation && GetAnimation(FollowUp) && GetWorld()->GetTimeSeconds() - AttackStartTime <= ComboWindow)
+    {
+        bComboQueued = true;
+    }
+}
+
+void AWarriorCharacter::StartAttack(EAnimationType Type)
+{
+    // Sheets without directional attacks still have the side swing
+    if (!GetAnimation(Type))
+    {
+        Type = EAnimationType::AttackSideways;
+    }
+
+    UPaperFlipbook* AttackAnimation = GetAnimation(Type);
+    if (!AttackAnimation)
+    {
+        return;
+    }
+
+    bIsAttacking = true;
+    bComboQueued = false;
+    AttackStartTime = GetWorld()->GetTimeSeconds();
+    PlayAnimation(Type);
+    
+    // End the attack when its clip does, so frame holds in the sheet lengthen it
+    const float AttackDuration = AttackAnimation->GetTotalDuration() > 0.0f ? AttackAnimation->GetTotalDuration() : 0.5f;
+    GetWorldTimerManager().SetTimer(AttackTimerHandle, this, &AWarriorCharacter::EndAttack, AttackDuration, false);
+    
+    UE_LOG(LogCharacterCreation, VeryVerbose, TEXT("Attack performed: %s"), *StaticEnum<EAnimationType>()->GetNameStringByValue(static_cast<int64>(Type)));
+}
+
+EAnimationType AWarriorCharacter::GetAttackForInput() const
+{
+    if (CurrentMoveUpValue > 0.1f)
+    {
+        return EAnimationType::AttackUpwards;
+    }
+    if (CurrentMoveUpValue < -0.1f)
+    {
+        return EAnimationType::AttackDownwards;
+    }
+    return EAnimationType::AttackSideways;
+}
+
+EAnimationType AWarriorCharacter::GetComboFollowUp(EAnimationType Type)
+{
+    switch (Type)
+    {
+        case EAnimationType::AttackSideways:
+            return EAnimationType::AttackSideways2;
+        case EAnimationType::AttackDownwards:
+            return EAnimationType::AttackDownwards2;
+        case EAnimationType::AttackUpwards:
+            return EAnimationType::AttackUpwards2;
+        default:
+            return Type;
     }
 }
 
@@ -310,20 +741,33 @@ void AWarriorCharacter::Tick(float DeltaTime)
 {
     Super::Tick(DeltaTime);
 
+    UpdateAnimationState();
+
+    // The pending transition is applied; sleep until the next input or attack event
+    if (bEventDrivenAnimation)
+    {
+        SetActorTickEnabled(false);
+    }
+}
+
+void AWarriorCharacter::RequestAnimationUpdate()
+{
+    // Several input events in one frame share a single update on the next tick
+    if (bEventDrivenAnimation && !IsActorTickEnabled())
+    {
+        SetActorTickEnabled(true);
+    }
+}
+
+void AWarriorCharacter::UpdateAnimationState()
+{
     // Update movement state
     bIsMoving = (FMath::Abs(CurrentMoveRightValue) > 0.1f || FMath::Abs(CurrentMoveUpValue) > 0.1f);
 
     // Update animation based on state
     if (!bIsAttacking)
     {
-        if (bIsMoving && MoveAnimation)
-        {
-            SetAnimation(MoveAnimation);
-        }
-        else if (!bIsMoving && IdleAnimation)
-        {
-            SetAnimation(IdleAnimation);
-        }
+        PlayAnimation(bIsMoving ? EAnimationType::Move : EAnimationType::Idle);
     }
 
     // Update sprite direction
@@ -336,7 +780,7 @@ void AWarriorCharacter::SetAnimation(UPaperFlipbook* NewAnimation)
 {
     if (SpriteComponent && NewAnimation)
     {
-        UE_LOG(LogCharacterCreation, Verbose, TEXT("SetAnimation called with: %s"), *NewAnimation->GetName());
+        UE_LOG(LogCharacterCreation, VeryVerbose, TEXT("SetAnimation called with: %s"), *NewAnimation->GetName());
         SpriteComponent->SetFlipbook(NewAnimation);
     }
     else
@@ -347,10 +791,48 @@ void AWarriorCharacter::SetAnimation(UPaperFlipbook* NewAnimation)
     }
 }
 
-void AWarriorCharacter::UpdateSpriteDirection()
+void AWarriorCharacter::PlayAnimation(EAnimationType Type)
 {
+    UPaperFlipbook* NewAnimation = GetAnimation(Type);
+    if (!NewAnimation)
+    {
+        return;
+    }
+
+    // Idle and move are requested every tick; only a change of clip reaches the component.
+    // Attacks always restart, a repeated swing included.
+    if (!IsAttack(Type) && Type == CurrentAnimation && SpriteComponent && SpriteComponent->GetFlipbook() == NewAnimation)
+    {
+        return;
+    }
+
+    INC_DWORD_STAT(STAT_WarriorFlipbookTransitions);
+    CurrentAnimation = Type;
+    SetAnimation(NewAnimation);
+
+    // Attacks start from their first frame; a finished attack would otherwise leave the component stopped
     if (SpriteComponent)
     {
+        SpriteComponent->SetLooping(AnimationLooping[static_cast<int32>(Type)]);
+        if (IsAttack(Type))
+        {
+            SpriteComponent->PlayFromStart();
+        }
+        else
+        {
+            SpriteComponent->Play();
+        }
+    }
+}
+
+void AWarriorCharacter::UpdateSpriteDirection()
+{
+    // Scale is only rewritten when the facing actually changed
+    if (SpriteComponent && bSpriteFacingRight != bFacingRight)
+    {
+        INC_DWORD_STAT(STAT_WarriorFacingFlips);
+        bSpriteFacingRight = bFacingRight;
+
         // Flip sprite based on facing direction
         FVector Scale = SpriteComponent->GetRelativeScale3D();
         if (bFacingRight)
@@ -368,57 +850,39 @@ void AWarriorCharacter::UpdateSpriteDirection()
 
 void AWarriorCharacter::EndAttack()
 {
+    if (bComboQueued)
+    {
+        StartAttack(GetComboFollowUp(CurrentAnimation));
+        return;
+    }
+
     bIsAttacking = false;
     
     // Return to appropriate animation
-    if (bIsMoving && MoveAnimation)
-    {
-        SetAnimation(MoveAnimation);
-    }
-    else if (IdleAnimation)
-    {
-        SetAnimation(IdleAnimation);
-    }
+    PlayAnimation(bIsMoving && GetAnimation(EAnimationType::Move) ? EAnimationType::Move : EAnimationType::Idle);
+
+    // Facing may have changed during the attack
+    RequestAnimationUpdate();
 }
 
 void AWarriorCharacter::LoadInputAssets()
 {
-    UE_LOG(LogCharacterCreation, Verbose, TEXT("=== LoadInputAssets() called in BeginPlay ==="));
-    
-    // Load input assets safely in BeginPlay (not in constructor)
-    if (!DefaultMappingContext)
-    {
-        DefaultMappingContext = LoadObject<UInputMappingContext>(nullptr, TEXT("/Game/Input/IMC_PlayerInput"));
-    }
-    if (!MoveAction)
-    {
-        MoveAction = LoadObject<UInputAction>(nullptr, TEXT("/Game/Input/IA_Move"));
-    }
-    if (!AttackAction)
-    {
-        AttackAction = LoadObject<UInputAction>(nullptr, TEXT("/Game/Input/IA_Attack"));
-    }
+    // Preloaded with the rest of the class's assets; only a warrior spawned without that blocks here
+    ResolveSoft(DefaultMappingContext, true);
+    ResolveSoft(MoveAction, true);
+    ResolveSoft(AttackAction, true);
     
     // Log what was loaded
     UE_LOG(LogCharacterCreation, Verbose, TEXT("Loaded input assets:"));
-    UE_LOG(LogCharacterCreation, Verbose, TEXT("- DefaultMappingContext: %s"), DefaultMappingContext ? TEXT("YES") : TEXT("NO"));
-    UE_LOG(LogCharacterCreation, Verbose, TEXT("- MoveAction: %s"), MoveAction ? TEXT("YES") : TEXT("NO"));
-    UE_LOG(LogCharacterCreation, Verbose, TEXT("- AttackAction: %s"), AttackAction ? TEXT("YES") : TEXT("NO"));
+    UE_LOG(LogCharacterCreation, Verbose, TEXT("- DefaultMappingContext: %s"), DefaultMappingContext.Get() ? TEXT("YES") : TEXT("NO"));
+    UE_LOG(LogCharacterCreation, Verbose, TEXT("- MoveAction: %s"), MoveAction.Get() ? TEXT("YES") : TEXT("NO"));
+    UE_LOG(LogCharacterCreation, Verbose, TEXT("- AttackAction: %s"), AttackAction.Get() ? TEXT("YES") : TEXT("NO"));
 }
 
 
-void AWarriorCharacter::TryLoadInputAssetsForEditor()
+void AWarriorCharacter::DeclareInputAssets()
 {
-    UE_LOG(LogCharacterCreation, Verbose, TEXT("=== TryLoadInputAssetsForEditor() called in constructor ==="));
-    
-    // Try to load input assets for editor display (will silently fail if assets don't exist yet)
-    DefaultMappingContext = LoadObject<UInputMappingContext>(nullptr, TEXT("/Game/Input/IMC_PlayerInput"));
-    MoveAction = LoadObject<UInputAction>(nullptr, TEXT("/Game/Input/IA_Move"));
-    AttackAction = LoadObject<UInputAction>(nullptr, TEXT("/Game/Input/IA_Attack"));
-    
-    // Log what was loaded
-    UE_LOG(LogCharacterCreation, Verbose, TEXT("Constructor loaded input assets:"));
-    UE_LOG(LogCharacterCreation, Verbose, TEXT("- DefaultMappingContext: %s"), DefaultMappingContext ? TEXT("YES") : TEXT("NO"));
-    UE_LOG(LogCharacterCreation, Verbose, TEXT("- MoveAction: %s"), MoveAction ? TEXT("YES") : TEXT("NO"));
-    UE_LOG(LogCharacterCreation, Verbose, TEXT("- AttackAction: %s"), AttackAction ? TEXT("YES") : TEXT("NO"));
-}
\ No newline at end of file
+    DefaultMappingContext = MakeAssetPath(TEXT("/Game/Input/IMC_PlayerInput"));
+    MoveAction = MakeAssetPath(TEXT("/Game/Input/IA_Move"));
+    AttackAction = MakeAssetPath(TEXT("/Game/Input/IA_Attack"));
+}
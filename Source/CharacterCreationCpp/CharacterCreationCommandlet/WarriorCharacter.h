@@ -14,6 +14,8 @@
 #include "InputActionValue.h"
 #include "InputAction.h"
 #include "InputMappingContext.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "WarriorAnimationSet.h"
 #include "WarriorCharacter.generated.h"
 
 UCLASS()
@@ -29,53 +31,71 @@ protected:
     virtual void BeginPlay() override;
     virtual void SetupPlayerInputComponent(UInputComponent* PlayerInputComponent) override;
     
-    // Virtual method for derived classes to override
+    // Copies this class's resolved assets into the animation table and palette (called from PostInitializeComponents)
     virtual void LoadAnimations();
     
-    // Load input assets (called from BeginPlay)
+    // Make sure the soft input references are loaded (called from BeginPlay and SetupPlayerInputComponent)
     void LoadInputAssets();
 
-    // Animation references - editable in Blueprint defaults
-    UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Animations")
-    class UPaperFlipbook* IdleAnimation;
-    
-    UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Animations")
-    class UPaperFlipbook* MoveAnimation;
-    
-    UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Animations")
-    class UPaperFlipbook* AttackUpAnimation;
-    
-    UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Animations")
-    class UPaperFlipbook* AttackDownAnimation;
-    
-    UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Animations")
-    class UPaperFlipbook* AttackSideAnimation;
-    
-    UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Animations")
-    class UPaperFlipbook* AttackUp2Animation;
-    
-    UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Animations")
-    class UPaperFlipbook* AttackDown2Animation;
-    
-    UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Animations")
-    class UPaperFlipbook* AttackSide2Animation;
+    // Point the soft animation references at the generated assets of SheetName, preferring the shared
+    // palette-swapped animations of PaletteBaseName when it is set. Only stores paths; nothing is loaded.
+    void DeclareAnimationAssets(const FString& SheetName, const FString& PaletteBaseName = FString());
+
+    // Render the sprite through PaletteMaterial with PaletteTexture (called from PostInitializeComponents)
+    void ApplyPalette();
+
+    // Soft references, declared by each warrior class and resolved once per class (see ResolveClassAssets)
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Animations")
+    TSoftObjectPtr<UWarriorAnimationSet> AnimationSet;
+
+    // Used instead of AnimationSet when the palette assets were generated
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Palette")
+    TSoftObjectPtr<UWarriorAnimationSet> PaletteAnimationSet;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Palette")
+    TSoftObjectPtr<UTexture2D> DefaultPalette;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Palette")
+    TSoftObjectPtr<UMaterialInterface> DefaultPaletteMaterial;
+
+    // One flipbook per EAnimationType, indexed by the enum value
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Animations", meta = (EditFixedSize))
+    TArray<TObjectPtr<UPaperFlipbook>> Animations;
+
+    // Whether each entry of Animations loops, from the animation set it was resolved from
+    TArray<bool> AnimationLooping;
+
+    // Palette swap - resolved from the palette references, null when the character uses full-color animations
+    UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Palette")
+    UTexture2D* PaletteTexture;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Palette")
+    UMaterialInterface* PaletteMaterial;
+
+    UPROPERTY(Transient)
+    UMaterialInstanceDynamic* PaletteMaterialInstance;
 
-    // Components
-    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
+    // Components - the camera rig only exists while a local player controls this warrior, so AI
+    // and crowd warriors carry no camera components
+    UPROPERTY(Transient, VisibleInstanceOnly, BlueprintReadOnly, Category = "Components")
     USpringArmComponent* SpringArmComponent;
 
-    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
+    UPROPERTY(Transient, VisibleInstanceOnly, BlueprintReadOnly, Category = "Components")
     UCameraComponent* CameraComponent;
 
+    // Off to leave the view to a shared camera rig (e.g. ACameraPawn) even for the player's warrior
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Camera")
+    bool bCreatePlayerCamera;
+
     // Enhanced Input
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Input")
-    UInputMappingContext* DefaultMappingContext;
+    TSoftObjectPtr<UInputMappingContext> DefaultMappingContext;
 
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Input")
-    UInputAction* MoveAction;
+    TSoftObjectPtr<UInputAction> MoveAction;
 
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Input")
-    UInputAction* AttackAction;
+    TSoftObjectPtr<UInputAction> AttackAction;
 
     // Movement variables
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Movement")
@@ -84,64 +104,123 @@ protected:
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Movement")
     float JumpVelocity;
 
+    // Tick only while an input or attack event has left a transition to apply, instead of polling
+    // every frame. Idle warriors then cost nothing per frame.
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Performance")
+    bool bEventDrivenAnimation;
+
+    // Seconds after an attack starts during which another press queues its follow-up
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Combat")
+    float ComboWindow;
+
     // State variables
     bool bIsMoving;
     bool bIsAttacking;
     bool bFacingRight;
+    bool bSpriteFacingRight;
+    bool bComboQueued;
+    EAnimationType CurrentAnimation;
+    float AttackStartTime;
     FTimerHandle AttackTimerHandle;
 
 public:
     virtual void Tick(float DeltaTime) override;
+    virtual void NotifyControllerChanged() override;
+    virtual void Destroyed() override;
+
+    // Every asset a warrior of Class refers to, for async preloading before spawning. Only packages that
+    // exist are returned; a palette character's own animation set is usually never generated.
+    static void GetPreloadPaths(TSubclassOf<AWarriorCharacter> Class, TArray<FSoftObjectPath>& OutPaths);
+
+    // Resolve Class's soft references once and cache the result for every warrior of that class.
+    // With bAllowSyncLoad false only already loaded assets are used, as after a preload; otherwise
+    // missing ones are loaded synchronously, with a warning only outside the editor and commandlets.
+    static void ResolveClassAssets(TSubclassOf<AWarriorCharacter> Class, bool bAllowSyncLoad);
+    static bool AreClassAssetsResolved(TSubclassOf<AWarriorCharacter> Class);
+
+    // Class's resolved flipbooks and their loop flags (indexed by EAnimationType) and palette, resolving them
+    // first if needed. For code that draws warriors without spawning them, such as UWarriorCrowdComponent.
+    static void GetClassAssets(TSubclassOf<AWarriorCharacter> Class, TArray<UPaperFlipbook*>& OutAnimations,
+        TArray<bool>& OutLooping, UTexture2D*& OutPaletteTexture, UMaterialInterface*& OutPaletteMaterial);
+
+    // Attacks restart on every press; whether a clip loops comes from its animation set
+    static bool IsAttack(EAnimationType Type) { return Type >= EAnimationType::AttackSideways; }
+
+    UFUNCTION(BlueprintCallable, Category = "Animations")
+    UPaperFlipbook* GetAnimation(EAnimationType Type) const { return Animations.IsValidIndex(static_cast<int32>(Type)) ? Animations[static_cast<int32>(Type)] : nullptr; }
+
+    UFUNCTION(BlueprintCallable, Category = "Animations")
+    void AssignAnimation(EAnimationType Type, UPaperFlipbook* Animation);
 
     // Public animation accessors for Python
     UFUNCTION(BlueprintCallable, Category = "Animations")
-    void SetIdleAnimation(UPaperFlipbook* Animation) { IdleAnimation = Animation; }
+    void SetIdleAnimation(UPaperFlipbook* Animation) { AssignAnimation(EAnimationType::Idle, Animation); }
     
     UFUNCTION(BlueprintCallable, Category = "Animations")
-    void SetMoveAnimation(UPaperFlipbook* Animation) { MoveAnimation = Animation; }
+    void SetMoveAnimation(UPaperFlipbook* Animation) { AssignAnimation(EAnimationType::Move, Animation); }
     
     UFUNCTION(BlueprintCallable, Category = "Animations")
-    void SetAttackUpAnimation(UPaperFlipbook* Animation) { AttackUpAnimation = Animation; }
+    void SetAttackUpAnimation(UPaperFlipbook* Animation) { AssignAnimation(EAnimationType::AttackUpwards, Animation); }
     
     UFUNCTION(BlueprintCallable, Category = "Animations")
-    void SetAttackDownAnimation(UPaperFlipbook* Animation) { AttackDownAnimation = Animation; }
+    void SetAttackDownAnimation(UPaperFlipbook* Animation) { AssignAnimation(EAnimationType::AttackDownwards, Animation); }
     
     UFUNCTION(BlueprintCallable, Category = "Animations")
-    void SetAttackSideAnimation(UPaperFlipbook* Animation) { AttackSideAnimation = Animation; }
+    void SetAttackSideAnimation(UPaperFlipbook* Animation) { AssignAnimation(EAnimationType::AttackSideways, Animation); }
     
     UFUNCTION(BlueprintCallable, Category = "Animations")
-    void SetAttackUp2Animation(UPaperFlipbook* Animation) { AttackUp2Animation = Animation; }
+    void SetAttackUp2Animation(UPaperFlipbook* Animation) { AssignAnimation(EAnimationType::AttackUpwards2, Animation); }
     
     UFUNCTION(BlueprintCallable, Category = "Animations")
-    void SetAttackDown2Animation(UPaperFlipbook* Animation) { AttackDown2Animation = Animation; }
+    void SetAttackDown2Animation(UPaperFlipbook* Animation) { AssignAnimation(EAnimationType::AttackDownwards2, Animation); }
     
     UFUNCTION(BlueprintCallable, Category = "Animations")
-    void SetAttackSide2Animation(UPaperFlipbook* Animation) { AttackSide2Animation = Animation; }
+    void SetAttackSide2Animation(UPaperFlipbook* Animation) { AssignAnimation(EAnimationType::AttackSideways2, Animation); }
 
     // Public animation getters for Python
     UFUNCTION(BlueprintCallable, Category = "Animations")
-    UPaperFlipbook* GetIdleAnimation() const { return IdleAnimation; }
+    UPaperFlipbook* GetIdleAnimation() const { return GetAnimation(EAnimationType::Idle); }
     
     UFUNCTION(BlueprintCallable, Category = "Animations")
-    UPaperFlipbook* GetMoveAnimation() const { return MoveAnimation; }
+    UPaperFlipbook* GetMoveAnimation() const { return GetAnimation(EAnimationType::Move); }
     
     UFUNCTION(BlueprintCallable, Category = "Animations")
-    UPaperFlipbook* GetAttackUpAnimation() const { return AttackUpAnimation; }
+    UPaperFlipbook* GetAttackUpAnimation() const { return GetAnimation(EAnimationType::AttackUpwards); }
     
     UFUNCTION(BlueprintCallable, Category = "Animations")
-    UPaperFlipbook* GetAttackDownAnimation() const { return AttackDownAnimation; }
+    UPaperFlipbook* GetAttackDownAnimation() const { return GetAnimation(EAnimationType::AttackDownwards); }
     
     UFUNCTION(BlueprintCallable, Category = "Animations")
-    UPaperFlipbook* GetAttackSideAnimation() const { return AttackSideAnimation; }
+    UPaperFlipbook* GetAttackSideAnimation() const { return GetAnimation(EAnimationType::AttackSideways); }
     
     UFUNCTION(BlueprintCallable, Category = "Animations")
-    UPaperFlipbook* GetAttackUp2Animation() const { return AttackUp2Animation; }
+    UPaperFlipbook* GetAttackUp2Animation() const { return GetAnimation(EAnimationType::AttackUpwards2); }
     
     UFUNCTION(BlueprintCallable, Category = "Animations")
-    UPaperFlipbook* GetAttackDown2Animation() const { return AttackDown2Animation; }
+    UPaperFlipbook* GetAttackDown2Animation() const { return GetAnimation(EAnimationType::AttackDownwards2); }
     
     UFUNCTION(BlueprintCallable, Category = "Animations")
-    UPaperFlipbook* GetAttackSide2Animation() const { return AttackSide2Animation; }
+    UPaperFlipbook* GetAttackSide2Animation() const { return GetAnimation(EAnimationType::AttackSideways2); }
+
+    // Swap colors at runtime; only a material parameter changes
+    UFUNCTION(BlueprintCallable, Category = "Palette")
+    void SetPalette(UTexture2D* NewPalette);
+
+    UFUNCTION(BlueprintCallable, Category = "Palette")
+    UTexture2D* GetPalette() const { return PaletteTexture; }
+
+    // Pooling (see UWarriorPoolSubsystem): a pooled warrior is hidden, without collision, movement,
+    // tick, flipbook playback or controller. Its AI controller is kept unpossessed and possesses it
+    // again on reactivation, which also resets the movement and attack state and restarts Idle.
+    void DeactivateForPool();
+    void ReactivateFromPool(const FTransform& SpawnTransform);
+    bool IsPooled() const { return bIsPooled; }
+
+    // Input without Enhanced Input, for AI and scripted warriors: call InjectMoveInput every frame the
+    // direction is held (as the Move action triggers), InjectStopMoveInput on release
+    void InjectMoveInput(const FVector2D& MoveValue) { Move(FInputActionValue(MoveValue)); }
+    void InjectStopMoveInput() { StopMove(FInputActionValue()); }
+    void InjectAttackInput() { Attack(FInputActionValue(true)); }
 
 protected:
     // Enhanced Input functions
@@ -151,13 +230,25 @@ protected:
 
     // Animation functions
     void SetAnimation(UPaperFlipbook* NewAnimation);
+    void PlayAnimation(EAnimationType Type);
+    void RequestAnimationUpdate();
+    void UpdateAnimationState();
+    void StartAttack(EAnimationType Type);
+    EAnimationType GetAttackForInput() const;
+    static EAnimationType GetComboFollowUp(EAnimationType Type);
     void UpdateSpriteDirection();
+    void UpdatePlayerCamera();
     void EndAttack();
     void LoadAndAssignAnimations();
-    void TryLoadInputAssetsForEditor();
+    void DeclareInputAssets();
 
 private:
     UPaperFlipbookComponent* SpriteComponent;
     float CurrentMoveRightValue;
     float CurrentMoveUpValue;
+    bool bIsPooled = false;
+
+    // The AI controller unpossessed by DeactivateForPool, reused instead of spawning a new one
+    UPROPERTY(Transient)
+    TObjectPtr<AController> PooledController;
 };
\ No newline at end of file
@@ -10,7 +10,7 @@ public class CharacterCreationCpp : ModuleRules
 	
 		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "EnhancedInput", "Paper2D", "GameplayTags" });
 
-		PrivateDependencyModuleNames.AddRange(new string[] { "UnrealEd", "EditorStyle", "EditorWidgets", "ToolMenus", "AssetRegistry", "ContentBrowser", "EditorSubsystem", "RenderCore", "ImageWrapper" });
+		PrivateDependencyModuleNames.AddRange(new string[] { "UnrealEd", "EditorStyle", "EditorWidgets", "ToolMenus", "AssetRegistry", "ContentBrowser", "EditorSubsystem", "RenderCore", "ImageWrapper", "Json" });
 		
 		// Add dependencies required for commandlets
 		if (Target.Type == TargetType.Editor || Target.Type == TargetType.Program)
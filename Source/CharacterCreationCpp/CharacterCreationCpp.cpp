@@ -14,13 +14,13 @@ class FCharacterCreationCppModule : public FDefaultGameModuleImpl
 public:
 	virtual void StartupModule() override
 	{
-		UE_LOG(LogCharacterCreation, Warning, TEXT("CharacterCreationCpp module started"));
-		UE_LOG(LogCharacterCreation, Warning, TEXT("CharacterCreationCommandlet available for command-line execution"));
+		UE_LOG(LogCharacterCreation, Log, TEXT("CharacterCreationCpp module started"));
+		UE_LOG(LogCharacterCreation, Verbose, TEXT("CharacterCreationCommandlet available for command-line execution"));
 	}
 
 	virtual void ShutdownModule() override
 	{
-		UE_LOG(LogCharacterCreation, Warning, TEXT("CharacterCreationCpp module shut down"));
+		UE_LOG(LogCharacterCreation, Log, TEXT("CharacterCreationCpp module shut down"));
 	}
 };
 
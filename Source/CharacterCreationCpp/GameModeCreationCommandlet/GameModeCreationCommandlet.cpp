@@ -1,4 +1,5 @@
 #include "GameModeCreationCommandlet.h"
+#include "CharacterCreationCommandlet/SourceTemplate.h"
 #include "HAL/FileManager.h"
 #include "HAL/PlatformFilemanager.h"
 #include "Misc/FileHelper.h"
@@ -83,12 +84,8 @@ bool UGameModeCreationCommandlet::CreateGameModeClass()
     FString HeaderPath = FPaths::Combine(SourceDir, TEXT("MyGameMode.h"));
     FString CppPath = FPaths::Combine(SourceDir, TEXT("MyGameMode.cpp"));
     
-    // Generate file contents
-    FString HeaderContent = GenerateGameModeHeader();
-    FString CppContent = GenerateGameModeCpp();
-    
     // Write header file
-    if (!WriteSourceFile(HeaderPath, HeaderContent))
+    if (!GenerateSourceFile(TEXT("MyGameMode.h"), HeaderPath))
     {
         UE_LOG(LogGameModeCreation, Error, TEXT("Failed to write header file: %s"), *HeaderPath);
         return false;
@@ -96,7 +93,7 @@ bool UGameModeCreationCommandlet::CreateGameModeClass()
     UE_LOG(LogGameModeCreation, Warning, TEXT("Created header file: %s"), *HeaderPath);
     
     // Write cpp file
-    if (!WriteSourceFile(CppPath, CppContent))
+    if (!GenerateSourceFile(TEXT("MyGameMode.cpp"), CppPath))
     {
         UE_LOG(LogGameModeCreation, Error, TEXT("Failed to write cpp file: %s"), *CppPath);
         return false;
@@ -106,108 +103,13 @@ bool UGameModeCreationCommandlet::CreateGameModeClass()
     return true;
 }
 
-FString UGameModeCreationCommandlet::GenerateGameModeHeader()
-{
-    return TEXT("#pragma once\n")
-           TEXT("\n")
-           TEXT("#include \"CoreMinimal.h\"\n")
-           TEXT("#include \"GameFramework/GameModeBase.h\"\n")
-           TEXT("#include \"MyGameMode.generated.h\"\n")
-           TEXT("\n")
-           TEXT("/**\n")
-           TEXT(" * Custom game mode that uses WarriorPurpleCharacter as the default pawn\n")
-           TEXT(" */\n")
-           TEXT("UCLASS()\n")
-           TEXT("class CHARACTERCREATIONCPP_API AMyGameMode : public AGameModeBase\n")
-           TEXT("{\n")
-           TEXT("    GENERATED_BODY()\n")
-           TEXT("\n")
-           TEXT("public:\n")
-           TEXT("    AMyGameMode();\n")
-           TEXT("\n")
-           TEXT("    /** Called when the game starts or when spawned */\n")
-           TEXT("    virtual void BeginPlay() override;\n")
-           TEXT("\n")
-           TEXT("protected:\n")
-           TEXT("    /** Override to specify the default pawn class */\n")
-           TEXT("    virtual void InitGameState() override;\n")
-           TEXT("};\n");
-}
-
-FString UGameModeCreationCommandlet::GenerateGameModeCpp()
-{
-    return TEXT("#include \"MyGameMode.h\"\n")
-           TEXT("#include \"CharacterCreationCommandlet/WarriorPurpleCharacter.h\"\n")
-           TEXT("#include \"Engine/Engine.h\"\n")
-           TEXT("#include \"Kismet/GameplayStatics.h\"\n")
-           TEXT("\n")
-           TEXT("AMyGameMode::AMyGameMode()\n")
-           TEXT("{\n")
-           TEXT("    // Set WarriorPurpleCharacter as the default pawn class\n")
-           TEXT("    static ConstructorHelpers::FClassFinder<APawn> PawnClassFinder(TEXT(\"/Script/CharacterCreationCpp.WarriorPurpleCharacter\"));\n")
-           TEXT("    if (PawnClassFinder.Succeeded())\n")
-           TEXT("    {\n")
-           TEXT("        DefaultPawnClass = PawnClassFinder.Class;\n")
-           TEXT("        UE_LOG(LogTemp, Warning, TEXT(\"MyGameMode: Successfully set WarriorPurpleCharacter as default pawn\"));\n")
-           TEXT("    }\n")
-           TEXT("    else\n")
-           TEXT("    {\n")
-           TEXT("        // Fallback: Try to load the class dynamically\n")
-           TEXT("        DefaultPawnClass = AWarriorPurpleCharacter::StaticClass();\n")
-           TEXT("        UE_LOG(LogTemp, Warning, TEXT(\"MyGameMode: Set WarriorPurpleCharacter using StaticClass()\"));\n")
-           TEXT("    }\n")
-           TEXT("    \n")
-           TEXT("    // Log the default pawn class for debugging\n")
-           TEXT("    if (DefaultPawnClass)\n")
-           TEXT("    {\n")
-           TEXT("        UE_LOG(LogTemp, Warning, TEXT(\"MyGameMode: Default Pawn Class is %s\"), *DefaultPawnClass->GetName());\n")
-           TEXT("    }\n")
-           TEXT("}\n")
-           TEXT("\n")
-           TEXT("void AMyGameMode::BeginPlay()\n")
-           TEXT("{\n")
-           TEXT("    Super::BeginPlay();\n")
-           TEXT("    \n")
-           TEXT("    UE_LOG(LogTemp, Warning, TEXT(\"MyGameMode: Game mode started with WarriorPurpleCharacter as default pawn\"));\n")
-           TEXT("    \n")
-           TEXT("    // Verify the default pawn class is set\n")
-           TEXT("    if (DefaultPawnClass)\n")
-           TEXT("    {\n")
-           TEXT("        UE_LOG(LogTemp, Warning, TEXT(\"MyGameMode: Using pawn class: %s\"), *DefaultPawnClass->GetName());\n")
-           TEXT("    }\n")
-           TEXT("    else\n")
-           TEXT("    {\n")
-           TEXT("        UE_LOG(LogTemp, Error, TEXT(\"MyGameMode: No default pawn class set!\"));\n")
-           TEXT("    }\n")
-           TEXT("}\n")
-           TEXT("\n")
-           TEXT("void AMyGameMode::InitGameState()\n")
-           TEXT("{\n")
-           TEXT("    Super::InitGameState();\n")
-           TEXT("    \n")
-           TEXT("    // Additional initialization if needed\n")
-           TEXT("    UE_LOG(LogTemp, Warning, TEXT(\"MyGameMode: Game state initialized\"));\n")
-           TEXT("}\n");
-}
-
-bool UGameModeCreationCommandlet::WriteSourceFile(const FString& FilePath, const FString& Content)
+bool UGameModeCreationCommandlet::GenerateSourceFile(const FString& TemplateName, const FString& FilePath)
 {
-    // Ensure the directory exists
-    FString Directory = FPaths::GetPath(FilePath);
-    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
-    if (!PlatformFile.DirectoryExists(*Directory))
-    {
-        if (!PlatformFile.CreateDirectoryTree(*Directory))
-        {
-            UE_LOG(LogGameModeCreation, Error, TEXT("Failed to create directory: %s"), *Directory);
-            return false;
-        }
-    }
-    
-    // Write the file
-    if (!FFileHelper::SaveStringToFile(Content, *FilePath))
+    bool bWritten = false;
+    FString Error;
+    if (!FSourceTemplate::Generate(TemplateName, FSourceTemplate::FArgs(), FilePath, bWritten, Error))
     {
-        UE_LOG(LogGameModeCreation, Error, TEXT("Failed to write file: %s"), *FilePath);
+        UE_LOG(LogGameModeCreation, Error, TEXT("%s"), *Error);
         return false;
     }
     
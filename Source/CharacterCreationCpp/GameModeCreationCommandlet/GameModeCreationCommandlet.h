@@ -21,8 +21,6 @@ private:
     bool SetDefaultGameMode();
     bool UpdateDefaultEngineIni();
     
-    FString GenerateGameModeHeader();
-    FString GenerateGameModeCpp();
-    
-    bool WriteSourceFile(const FString& FilePath, const FString& Content);
+    // Renders CodeTemplates/<TemplateName>.template into FilePath
+    bool GenerateSourceFile(const FString& TemplateName, const FString& FilePath);
 };
\ No newline at end of file
@@ -21,10 +21,19 @@
 #include "Components/StaticMeshComponent.h"
 #include "Engine/StaticMesh.h"
 #include "UObject/GarbageCollection.h"
+#include "../WarriorBlueCharacter.h"
 #include "../WarriorPurpleCharacter.h"
+#include "../WarriorRedCharacter.h"
+#include "../CharacterCreationCommandlet/SpritePipelineProfiler.h"
 #include "GameFramework/PlayerStart.h"
+#include "GameFramework/WorldSettings.h"
 #include "PaperFlipbook.h"
 #include "PaperFlipbookComponent.h"
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/App.h"
 
 // Include headers for atmosphere actors
 #include "Atmosphere/AtmosphericFog.h"
@@ -41,7 +50,7 @@ ULevelCreationCommandlet::ULevelCreationCommandlet()
 	LogToConsole = true;
 	ShowErrorCount = true;
 	HelpDescription = TEXT("Create new levels with environmental actors");
-	HelpUsage = TEXT("LevelCreationCommandlet [-mapname=<MapName>] [-outputpath=<OutputPath>] [-dryrun]");
+	HelpUsage = TEXT("LevelCreationCommandlet [-mapname=<MapName>] [-outputpath=<OutputPath>] [-dryrun] [-stress [-warriors=<N>] [-spacing=<Units>] [-frames=<N>] [-warmup=<N>] [-fps=<N>] [-seed=<N>] [-report=<Path>]]");
 }
 
 int32 ULevelCreationCommandlet::Main(const FString& Params)
@@ -50,10 +59,18 @@ int32 ULevelCreationCommandlet::Main(const FString& Params)
 	UE_LOG(LogLevelCreation, Warning, TEXT("Parameters: %s"), *Params);
 
 	// Parse parameters
-	FString MapName = TEXT("Map1");
+	const bool bStress = FParse::Param(*Params, TEXT("stress"));
+	FString MapName = bStress ? TEXT("StressMap") : TEXT("Map1");
 	FString OutputPath = TEXT("/Game/Maps/");
 	bool bDryRun = FParse::Param(*Params, TEXT("dryrun"));
 
+	FStressSettings Stress;
+	if (bStress && !ParseStressSettings(Params, Stress))
+	{
+		PrintUsage();
+		return 1;
+	}
+
 	FParse::Value(*Params, TEXT("mapname="), MapName);
 	FParse::Value(*Params, TEXT("m="), MapName);
 	FParse::Value(*Params, TEXT("outputpath="), OutputPath);
@@ -82,17 +99,23 @@ int32 ULevelCreationCommandlet::Main(const FString& Params)
 	// Handle dry run
 	if (bDryRun)
 	{
-		PrintDryRunSummary(MapName, OutputPath);
+		PrintDryRunSummary(MapName, OutputPath, Stress);
 		UE_LOG(LogLevelCreation, Warning, TEXT("=== Level Creation Commandlet Dry Run Completed ==="));
 		return 0;
 	}
 
 	// Create the level
-	bool bSuccess = CreateLevel(MapName, OutputPath, bDryRun);
+	bool bSuccess = CreateLevel(MapName, OutputPath, bDryRun, Stress);
 
 	if (bSuccess)
 	{
-		PrintSuccess(MapName, OutputPath + MapName);
+		PrintSuccess(MapName, OutputPath + MapName, Stress);
+
+		if (Stress.NumWarriors > 0 && Stress.Frames > 0 && !RunStressBenchmark(Stress))
+		{
+			UE_LOG(LogLevelCreation, Error, TEXT("=== Level Creation Commandlet Failed: stress benchmark did not complete ==="));
+			return 1;
+		}
 		
 		// Clean up memory before exiting
 		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
@@ -108,7 +131,7 @@ int32 ULevelCreationCommandlet::Main(const FString& Params)
 	}
 }
 
-bool ULevelCreationCommandlet::CreateLevel(const FString& MapName, const FString& OutputPath, bool bDryRun)
+bool ULevelCreationCommandlet::CreateLevel(const FString& MapName, const FString& OutputPath, bool bDryRun, const FStressSettings& Stress)
 {
 	UE_LOG(LogLevelCreation, Warning, TEXT("Creating new world..."));
 
@@ -137,7 +160,7 @@ bool ULevelCreationCommandlet::CreateLevel(const FString& MapName, const FString
 	UE_LOG(LogLevelCreation, Warning, TEXT("✓ World created successfully"));
 
 	// Spawn environmental actors
-	bool bActorsSpawned = SpawnEnvironmentalActors(NewWorld);
+	bool bActorsSpawned = SpawnEnvironmentalActors(NewWorld, Stress);
 	if (!bActorsSpawned)
 	{
 		UE_LOG(LogLevelCreation, Error, TEXT("Failed to spawn environmental actors"));
@@ -151,7 +174,7 @@ bool ULevelCreationCommandlet::CreateLevel(const FString& MapName, const FString
 	return bSaved;
 }
 
-bool ULevelCreationCommandlet::SpawnEnvironmentalActors(UWorld* World)
+bool ULevelCreationCommandlet::SpawnEnvironmentalActors(UWorld* World, const FStressSettings& Stress)
 {
 	if (!World)
 	{
@@ -214,7 +237,22 @@ bool ULevelCreationCommandlet::SpawnEnvironmentalActors(UWorld* World)
 	}
 	UE_LOG(LogLevelCreation, Warning, TEXT("✓ Plane Actor spawned"));
 
-	// 7. Spawn Warrior Purple Character on top of the plane
+	// 7. Stress mode: a warrior grid on a ground sized to fit it, in place of the player warrior
+	if (Stress.NumWarriors > 0)
+	{
+		ScaleGroundToWarriorGrid(PlaneActor, Stress);
+
+		TArray<AWarriorCharacter*> Warriors;
+		if (!SpawnWarriorGrid(World, Stress, false, Warriors))
+		{
+			UE_LOG(LogLevelCreation, Error, TEXT("Failed to spawn the warrior grid"));
+			return false;
+		}
+		UE_LOG(LogLevelCreation, Warning, TEXT("✓ %d warriors spawned"), Warriors.Num());
+		return true;
+	}
+
+	// 8. Spawn Warrior Purple Character on top of the plane
 	// Calculate spawn location: plane is at (0,0,0) with scale 8x8x8
 	// The plane mesh is 100x100 units by default, so scaled it's 800x800 units
 	// Spawn character slightly above the plane surface
@@ -496,15 +534,23 @@ void ULevelCreationCommandlet::PrintUsage() const
 	UE_LOG(LogLevelCreation, Warning, TEXT("  -mapname=<name>      | -m=<name>    Name of the map to create (default: Map1)"));
 	UE_LOG(LogLevelCreation, Warning, TEXT("  -outputpath=<path>   | -o=<path>    Output path for the map (default: /Game/Maps/)"));
 	UE_LOG(LogLevelCreation, Warning, TEXT("  -dryrun                              Preview operations without creating files"));
+	UE_LOG(LogLevelCreation, Warning, TEXT("  -stress                              Build a warrior grid map (default: StressMap) and benchmark it"));
+	UE_LOG(LogLevelCreation, Warning, TEXT("    -warriors=<N>                      Warriors in the grid, mixed colors (default: %d, max: %d)"), DefaultStressWarriors, MaxStressWarriors);
+	UE_LOG(LogLevelCreation, Warning, TEXT("    -spacing=<units>                   Distance between grid cells (default: 150)"));
+	UE_LOG(LogLevelCreation, Warning, TEXT("    -frames=<N> -warmup=<N>            Measured and discarded frames (default: 600 and 60, -frames=0 only builds the map)"));
+	UE_LOG(LogLevelCreation, Warning, TEXT("    -fps=<N>                           Fixed simulation rate (default: 30)"));
+	UE_LOG(LogLevelCreation, Warning, TEXT("    -seed=<N>                          Seed of the scripted input"));
+	UE_LOG(LogLevelCreation, Warning, TEXT("    -report=<path>                     Write the frame statistics as JSON"));
 	UE_LOG(LogLevelCreation, Warning, TEXT(""));
 	UE_LOG(LogLevelCreation, Warning, TEXT("Examples:"));
 	UE_LOG(LogLevelCreation, Warning, TEXT("  LevelCreationCommandlet"));
 	UE_LOG(LogLevelCreation, Warning, TEXT("  LevelCreationCommandlet -mapname=MyLevel"));
 	UE_LOG(LogLevelCreation, Warning, TEXT("  LevelCreationCommandlet -m=TestMap -o=/Game/MyMaps/ -dryrun"));
+	UE_LOG(LogLevelCreation, Warning, TEXT("  LevelCreationCommandlet -stress -warriors=2000 -frames=900 -nullrhi"));
 	UE_LOG(LogLevelCreation, Warning, TEXT(""));
 }
 
-void ULevelCreationCommandlet::PrintSuccess(const FString& MapName, const FString& PackagePath) const
+void ULevelCreationCommandlet::PrintSuccess(const FString& MapName, const FString& PackagePath, const FStressSettings& Stress) const
 {
 	UE_LOG(LogLevelCreation, Warning, TEXT(""));
 	UE_LOG(LogLevelCreation, Warning, TEXT("✓ SUCCESS! Level created successfully"));
@@ -521,9 +567,17 @@ void ULevelCreationCommandlet::PrintSuccess(const FString& MapName, const FStrin
 	UE_LOG(LogLevelCreation, Warning, TEXT("🌌 Sky Atmosphere"));
 	UE_LOG(LogLevelCreation, Warning, TEXT("☁️  Volumetric Cloud"));
 	UE_LOG(LogLevelCreation, Warning, TEXT("🌫️  Exponential Height Fog"));
-	UE_LOG(LogLevelCreation, Warning, TEXT("🏗️  Plane Static Mesh (Ground) - Scale: 8x8x8"));
-	UE_LOG(LogLevelCreation, Warning, TEXT("🎮 Warrior Purple Character"));
-	UE_LOG(LogLevelCreation, Warning, TEXT("🚩 Player Start"));
+	if (Stress.NumWarriors > 0)
+	{
+		UE_LOG(LogLevelCreation, Warning, TEXT("🏗️  Plane Static Mesh (Ground) - Sized to the warrior grid"));
+		UE_LOG(LogLevelCreation, Warning, TEXT("🎮 %d Warriors (Blue, Purple, Red) - Spacing: %.0f"), Stress.NumWarriors, Stress.Spacing);
+	}
+	else
+	{
+		UE_LOG(LogLevelCreation, Warning, TEXT("🏗️  Plane Static Mesh (Ground) - Scale: 8x8x8"));
+		UE_LOG(LogLevelCreation, Warning, TEXT("🎮 Warrior Purple Character"));
+		UE_LOG(LogLevelCreation, Warning, TEXT("🚩 Player Start"));
+	}
 	UE_LOG(LogLevelCreation, Warning, TEXT(""));
 	UE_LOG(LogLevelCreation, Warning, TEXT("📋 Open the level in the Unreal Editor to see your new environment!"));
 }
@@ -541,7 +595,7 @@ void ULevelCreationCommandlet::PrintFailure(const FString& MapName) const
 	UE_LOG(LogLevelCreation, Error, TEXT("4. Check the log for specific error messages"));
 }
 
-void ULevelCreationCommandlet::PrintDryRunSummary(const FString& MapName, const FString& OutputPath) const
+void ULevelCreationCommandlet::PrintDryRunSummary(const FString& MapName, const FString& OutputPath, const FStressSettings& Stress) const
 {
 	UE_LOG(LogLevelCreation, Warning, TEXT(""));
 	UE_LOG(LogLevelCreation, Warning, TEXT("════════════════════════════════════════════════════"));
@@ -560,9 +614,20 @@ void ULevelCreationCommandlet::PrintDryRunSummary(const FString& MapName, const
 	UE_LOG(LogLevelCreation, Warning, TEXT("  • Sky Atmosphere"));
 	UE_LOG(LogLevelCreation, Warning, TEXT("  • Volumetric Cloud"));
 	UE_LOG(LogLevelCreation, Warning, TEXT("  • Exponential Height Fog"));
-	UE_LOG(LogLevelCreation, Warning, TEXT("  • Plane Static Mesh (Ground) - Scale: 8x8x8"));
-	UE_LOG(LogLevelCreation, Warning, TEXT("  • Warrior Purple Character"));
-	UE_LOG(LogLevelCreation, Warning, TEXT("  • Player Start"));
+	if (Stress.NumWarriors > 0)
+	{
+		UE_LOG(LogLevelCreation, Warning, TEXT("  • Plane Static Mesh (Ground) - Sized to the warrior grid"));
+		UE_LOG(LogLevelCreation, Warning, TEXT("  • %d Warriors (Blue, Purple, Red) - Spacing: %.0f"), Stress.NumWarriors, Stress.Spacing);
+		UE_LOG(LogLevelCreation, Warning, TEXT(""));
+		UE_LOG(LogLevelCreation, Warning, TEXT("Stress Benchmark:"));
+		UE_LOG(LogLevelCreation, Warning, TEXT("  • %d warmup + %d measured frames at %.0f fps"), Stress.WarmupFrames, Stress.Frames, Stress.FrameRate);
+	}
+	else
+	{
+		UE_LOG(LogLevelCreation, Warning, TEXT("  • Plane Static Mesh (Ground) - Scale: 8x8x8"));
+		UE_LOG(LogLevelCreation, Warning, TEXT("  • Warrior Purple Character"));
+		UE_LOG(LogLevelCreation, Warning, TEXT("  • Player Start"));
+	}
 	UE_LOG(LogLevelCreation, Warning, TEXT(""));
 	UE_LOG(LogLevelCreation, Warning, TEXT("No files have been created or modified."));
 	UE_LOG(LogLevelCreation, Warning, TEXT("Remove -dryrun flag to execute these operations."));
@@ -679,4 +744,307 @@ AWarriorPurpleCharacter* ULevelCreationCommandlet::SpawnWarriorPurpleCharacter(U
 	}
 
 	return WarriorCharacter;
-}
\ No newline at end of file
+}
+
+// Colors placed round-robin in the stress grid
+static TArray<UClass*> GetStressWarriorClasses()
+{
+	return { AWarriorBlueCharacter::StaticClass(), AWarriorPurpleCharacter::StaticClass(), AWarriorRedCharacter::StaticClass() };
+}
+
+FVector ULevelCreationCommandlet::GetWarriorGridLocation(int32 Index, const FStressSettings& Stress) const
+{
+	// Square-ish grid centered on the origin, 50 units above the plane like the player warrior
+	const int32 Columns = FMath::CeilToInt32(FMath::Sqrt(static_cast<float>(Stress.NumWarriors)));
+	const int32 Rows = FMath::DivideAndRoundUp(Stress.NumWarriors, Columns);
+	return FVector(
+		((Index % Columns) - (Columns - 1) * 0.5f) * Stress.Spacing,
+		((Index / Columns) - (Rows - 1) * 0.5f) * Stress.Spacing,
+		50.0f);
+}
+
+void ULevelCreationCommandlet::ScaleGroundToWarriorGrid(AStaticMeshActor* PlaneActor, const FStressSettings& Stress) const
+{
+	// The plane mesh is 100x100 units; leave two cells of margin around the grid for wandering warriors
+	const int32 Columns = FMath::CeilToInt32(FMath::Sqrt(static_cast<float>(Stress.NumWarriors)));
+	const float Scale = FMath::Max(8.0f, (Columns + 4) * Stress.Spacing / 100.0f);
+	PlaneActor->SetActorScale3D(FVector(Scale, Scale, 8.0f));
+}
+
+bool ULevelCreationCommandlet::SpawnWarriorGrid(UWorld* World, const FStressSettings& Stress, bool bForPlay, TArray<AWarriorCharacter*>& OutWarriors)
+{
+	const TArray<UClass*> WarriorClasses = GetStressWarriorClasses();
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	OutWarriors.Reserve(Stress.NumWarriors);
+	for (int32 Index = 0; Index < Stress.NumWarriors; Index++)
+	{
+		UClass* WarriorClass = WarriorClasses[Index % WarriorClasses.Num()];
+		AWarriorCharacter* Warrior = World->SpawnActor<AWarriorCharacter>(WarriorClass, GetWarriorGridLocation(Index, Stress), FRotator::ZeroRotator, SpawnParams);
+		if (!Warrior)
+		{
+			UE_LOG(LogLevelCreation, Error, TEXT("Failed to spawn warrior %d (%s)"), Index, *WarriorClass->GetName());
+			return false;
+		}
+
+		if (bForPlay)
+		{
+			// Servers simulate AI-controlled warriors, and movement input needs a controller
+			Warrior->SpawnDefaultController();
+		}
+		else
+		{
+			// Placed warriors get their AI controller when the map is played
+			Warrior->SetActorLabel(FString::Printf(TEXT("Warrior_%04d"), Index));
+		}
+		OutWarriors.Add(Warrior);
+	}
+
+	return true;
+}
+
+bool ULevelCreationCommandlet::ParseStressSettings(const FString& Params, FStressSettings& OutStress) const
+{
+	OutStress.NumWarriors = DefaultStressWarriors;
+	FParse::Value(*Params, TEXT("warriors="), OutStress.NumWarriors);
+	FParse::Value(*Params, TEXT("spacing="), OutStress.Spacing);
+	FParse::Value(*Params, TEXT("frames="), OutStress.Frames);
+	FParse::Value(*Params, TEXT("warmup="), OutStress.WarmupFrames);
+	FParse::Value(*Params, TEXT("fps="), OutStress.FrameRate);
+	FParse::Value(*Params, TEXT("seed="), OutStress.Seed);
+	if (FParse::Value(*Params, TEXT("report="), OutStress.ReportPath))
+	{
+		OutStress.ReportPath = FPaths::ConvertRelativePathToFull(OutStress.ReportPath);
+	}
+
+	if (OutStress.NumWarriors <= 0 || OutStress.NumWarriors > MaxStressWarriors)
+	{
+		UE_LOG(LogLevelCreation, Error, TEXT("Invalid warrior count: %d (valid range: 1-%d)"), OutStress.NumWarriors, MaxStressWarriors);
+		return false;
+	}
+
+	if (OutStress.Spacing < 50.0f)
+	{
+		UE_LOG(LogLevelCreation, Error, TEXT("Invalid spacing: %.1f (must be at least 50 so capsules do not overlap)"), OutStress.Spacing);
+		return false;
+	}
+
+	if (OutStress.Frames < 0 || OutStress.WarmupFrames < 0 || OutStress.FrameRate <= 0.0f || OutStress.FrameRate > 240.0f)
+	{
+		UE_LOG(LogLevelCreation, Error, TEXT("Invalid frame settings: frames=%d, warmup=%d, fps=%.1f"), OutStress.Frames, OutStress.WarmupFrames, OutStress.FrameRate);
+		return false;
+	}
+
+	return true;
+}
+
+bool ULevelCreationCommandlet::RunStressBenchmark(const FStressSettings& Stress)
+{
+	UE_LOG(LogLevelCreation, Warning, TEXT("Running stress benchmark: %d warriors, %d frames at %.0f fps..."), Stress.NumWarriors, Stress.Frames, Stress.FrameRate);
+	if (FApp::CanEverRender())
+	{
+		UE_LOG(LogLevelCreation, Warning, TEXT("Rendering is enabled; run with -nullrhi to measure the simulation alone"));
+	}
+
+	// Load every color's assets first so neither loading time nor asset memory is attributed to the warriors
+	for (UClass* WarriorClass : GetStressWarriorClasses())
+	{
+		if (!AWarriorCharacter::AreClassAssetsResolved(WarriorClass))
+		{
+			AWarriorCharacter::ResolveClassAssets(WarriorClass, true);
+		}
+	}
+
+	// A game world, so actors begin play and tick, separate from the saved editor world
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("WarriorStressBenchmark"));
+	if (!World)
+	{
+		UE_LOG(LogLevelCreation, Error, TEXT("Failed to create benchmark world"));
+		return false;
+	}
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+	World->InitializeActorsForPlay(FURL());
+
+	AStaticMeshActor* PlaneActor = SpawnPlaneActor(World);
+	if (PlaneActor)
+	{
+		ScaleGroundToWarriorGrid(PlaneActor, Stress);
+	}
+
+	// There is no game mode to start play; dispatch BeginPlay as the game state would
+	World->GetWorldSettings()->NotifyBeginPlay();
+
+	// Fixed steps keep the scripted input and the timers identical from run to run
+	const float DeltaSeconds = 1.0f / Stress.FrameRate;
+	auto TickWorld = [World, DeltaSeconds]()
+	{
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		FApp::SetDeltaTime(DeltaSeconds);
+		FApp::SetCurrentTime(FApp::GetCurrentTime() + DeltaSeconds);
+		World->Tick(LEVELTICK_All, DeltaSeconds);
+		GFrameCounter++;
+		return FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles);
+	};
+
+	// The empty world's frame time is subtracted to get the warriors' share
+	TArray<double> EmptyFrameMs;
+	EmptyFrameMs.Reserve(StressBaselineFrames);
+	for (int32 Frame = 0; Frame < StressBaselineFrames; Frame++)
+	{
+		EmptyFrameMs.Add(TickWorld());
+	}
+	const double BaselineMs = FPerformanceReport::GetPercentile(EmptyFrameMs, 50.0);
+
+	const uint64 UsedPhysicalBeforeSpawn = FPlatformMemory::GetStats().UsedPhysical;
+	TArray<AWarriorCharacter*> Warriors;
+	bool bSuccess = SpawnWarriorGrid(World, Stress, true, Warriors);
+	const int64 WarriorBytes = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical) - static_cast<int64>(UsedPhysicalBeforeSpawn);
+
+	if (bSuccess)
+	{
+		// Each warrior wanders around its grid cell, stops and attacks on its own random schedule
+		struct FScriptedInput
+		{
+			FRandomStream Stream;
+			FVector2D MoveValue = FVector2D::ZeroVector;
+			float NextDecisionTime = 0.0f;
+			UPaperFlipbook* LastFlipbook = nullptr;
+		};
+		TArray<FScriptedInput> Scripts;
+		Scripts.SetNum(Warriors.Num());
+		for (int32 Index = 0; Index < Scripts.Num(); Index++)
+		{
+			Scripts[Index].Stream.Initialize(Stress.Seed + Index);
+		}
+
+		TArray<double> FrameMs;
+		double WorldTickMs = 0.0;
+		int64 FlipbookChanges = 0;
+		FrameMs.Reserve(Stress.Frames);
+
+		for (int32 Frame = 0; Frame < Stress.WarmupFrames + Stress.Frames; Frame++)
+		{
+			const uint64 InputStartCycles = FPlatformTime::Cycles64();
+			const float Time = World->GetTimeSeconds();
+			for (int32 Index = 0; Index < Warriors.Num(); Index++)
+			{
+				AWarriorCharacter* Warrior = Warriors[Index];
+				FScriptedInput& Script = Scripts[Index];
+				if (Time >= Script.NextDecisionTime)
+				{
+					Script.NextDecisionTime = Time + Script.Stream.FRandRange(0.5f, 2.0f);
+					const FVector ToCell = GetWarriorGridLocation(Index, Stress) - Warrior->GetActorLocation();
+					const float Roll = Script.Stream.FRand();
+					if (ToCell.Size2D() > Stress.Spacing)
+					{
+						// Head back before wandering off the ground; Move inverts the Y axis
+						Script.MoveValue = FVector2D(ToCell.X, -ToCell.Y).GetSafeNormal();
+					}
+					else if (Roll < 0.2f)
+					{
+						Script.MoveValue = FVector2D::ZeroVector;
+						Warrior->InjectStopMoveInput();
+					}
+					else if (Roll < 0.4f)
+					{
+						Warrior->InjectAttackInput();
+					}
+					else
+					{
+						const float Angle = Script.Stream.FRandRange(0.0f, 2.0f * PI);
+						Script.MoveValue = FVector2D(FMath::Cos(Angle), FMath::Sin(Angle));
+					}
+				}
+
+				if (!Script.MoveValue.IsZero())
+				{
+					Warrior->InjectMoveInput(Script.MoveValue);
+				}
+			}
+			const double InputMs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - InputStartCycles);
+			const double TickMs = TickWorld();
+
+			// Outside the timed span: how many warriors switched clips this frame
+			int32 Changes = 0;
+			for (int32 Index = 0; Index < Warriors.Num(); Index++)
+			{
+				UPaperFlipbook* Flipbook = Warriors[Index]->GetSprite()->GetFlipbook();
+				Changes += Flipbook != Scripts[Index].LastFlipbook ? 1 : 0;
+				Scripts[Index].LastFlipbook = Flipbook;
+			}
+
+			if (Frame >= Stress.WarmupFrames)
+			{
+				FrameMs.Add(InputMs + TickMs);
+				WorldTickMs += TickMs;
+				FlipbookChanges += Changes;
+			}
+		}
+
+		const double MeanTickMs = Stress.Frames > 0 ? WorldTickMs / Stress.Frames : 0.0;
+		const double TickUsPerWarrior = FMath::Max(0.0, MeanTickMs - BaselineMs) * 1000.0 / Warriors.Num();
+		const double FlipbookChangesPerFrame = Stress.Frames > 0 ? static_cast<double>(FlipbookChanges) / Stress.Frames : 0.0;
+		const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+		const double FrameBudgetMs = 1000.0 / Stress.FrameRate;
+
+		UE_LOG(LogLevelCreation, Warning, TEXT(""));
+		UE_LOG(LogLevelCreation, Warning, TEXT("Stress Benchmark Results (%d warriors, %d frames):"), Warriors.Num(), Stress.Frames);
+		UE_LOG(LogLevelCreation, Warning, TEXT("━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━"));
+		UE_LOG(LogLevelCreation, Warning, TEXT("Game thread:    p50 %.2f ms, p95 %.2f ms, max %.2f ms"),
+			FPerformanceReport::GetPercentile(FrameMs, 50.0), FPerformanceReport::GetPercentile(FrameMs, 95.0), FPerformanceReport::GetPercentile(FrameMs, 100.0));
+		UE_LOG(LogLevelCreation, Warning, TEXT("Empty world:    %.2f ms per frame"), BaselineMs);
+		UE_LOG(LogLevelCreation, Warning, TEXT("Tick cost:      %.2f us per warrior"), TickUsPerWarrior);
+		UE_LOG(LogLevelCreation, Warning, TEXT("Flipbooks:      %.1f clip changes per frame (%lld total)"), FlipbookChangesPerFrame, FlipbookChanges);
+		UE_LOG(LogLevelCreation, Warning, TEXT("Memory:         %.1f KB per warrior, %.1f MB used, %.1f MB peak"),
+			WarriorBytes / 1024.0 / Warriors.Num(), MemoryStats.UsedPhysical / (1024.0 * 1024.0), MemoryStats.PeakUsedPhysical / (1024.0 * 1024.0));
+		if (TickUsPerWarrior > 0.0)
+		{
+			UE_LOG(LogLevelCreation, Warning, TEXT("Capacity:       ~%d warriors in a %.1f ms frame"),
+				FMath::FloorToInt32(FMath::Max(0.0, FrameBudgetMs - BaselineMs) * 1000.0 / TickUsPerWarrior), FrameBudgetMs);
+		}
+
+		if (!Stress.ReportPath.IsEmpty())
+		{
+			bSuccess = WriteStressReport(Stress, FrameMs, BaselineMs, TickUsPerWarrior, FlipbookChangesPerFrame, WarriorBytes);
+		}
+	}
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	return bSuccess;
+}
+
+bool ULevelCreationCommandlet::WriteStressReport(const FStressSettings& Stress, const TArray<double>& FrameMs, double BaselineMs, double TickUsPerWarrior,
+	double FlipbookChangesPerFrame, int64 WarriorBytes) const
+{
+	TSharedRef<FJsonObject> Root = FPerformanceReport::MakeRoot(1);
+	Root->SetNumberField(TEXT("Warriors"), Stress.NumWarriors);
+	Root->SetNumberField(TEXT("Spacing"), Stress.Spacing);
+	Root->SetNumberField(TEXT("Frames"), Stress.Frames);
+	Root->SetNumberField(TEXT("WarmupFrames"), Stress.WarmupFrames);
+	Root->SetNumberField(TEXT("FrameRate"), Stress.FrameRate);
+	Root->SetNumberField(TEXT("Seed"), Stress.Seed);
+
+	Root->SetObjectField(TEXT("GameThreadMs"), FPerformanceReport::MakePercentiles(FrameMs, 95));
+
+	Root->SetNumberField(TEXT("EmptyWorldMs"), BaselineMs);
+	Root->SetNumberField(TEXT("EmptyWorldFrames"), StressBaselineFrames);
+	Root->SetNumberField(TEXT("TickUsPerWarrior"), TickUsPerWarrior);
+	Root->SetNumberField(TEXT("FlipbookChangesPerFrame"), FlipbookChangesPerFrame);
+	Root->SetNumberField(TEXT("BytesPerWarrior"), static_cast<double>(WarriorBytes) / Stress.NumWarriors);
+	Root->SetNumberField(TEXT("PeakUsedPhysicalBytes"), static_cast<double>(FPlatformMemory::GetStats().PeakUsedPhysical));
+
+	if (!FPerformanceReport::Write(Root, Stress.ReportPath))
+	{
+		UE_LOG(LogLevelCreation, Error, TEXT("Failed to write stress report: %s"), *Stress.ReportPath);
+		return false;
+	}
+
+	UE_LOG(LogLevelCreation, Warning, TEXT("✓ Stress report written to: %s"), *Stress.ReportPath);
+	return true;
+}
@@ -14,13 +14,32 @@ public:
 
 	virtual int32 Main(const FString& Params) override;
 
+	static constexpr int32 DefaultStressWarriors = 500;
+	static constexpr int32 MaxStressWarriors = 10000;
+
+	// Empty-world frames timed for the stress baseline, independent of -warmup so runs stay comparable
+	static constexpr int32 StressBaselineFrames = 120;
+
 private:
+	// Stress mode (-stress): the map gets a grid of warriors of every color instead of the single
+	// player warrior, and the same grid is then simulated for a fixed number of frames
+	struct FStressSettings
+	{
+		int32 NumWarriors = 0;
+		float Spacing = 150.0f;
+		int32 Frames = 600;
+		int32 WarmupFrames = 60;
+		float FrameRate = 30.0f;
+		int32 Seed = 1234;
+		FString ReportPath;
+	};
+
 	// Level creation
-	bool CreateLevel(const FString& MapName, const FString& OutputPath, bool bDryRun);
+	bool CreateLevel(const FString& MapName, const FString& OutputPath, bool bDryRun, const FStressSettings& Stress);
 	bool SaveLevel(class UWorld* World, const FString& PackageName);
 	
 	// Actor spawning
-	bool SpawnEnvironmentalActors(class UWorld* World);
+	bool SpawnEnvironmentalActors(class UWorld* World, const FStressSettings& Stress);
 	class ADirectionalLight* SpawnDirectionalLight(class UWorld* World);
 	class ASkyLight* SpawnSkyLight(class UWorld* World);
 	class ASkyAtmosphere* SpawnSkyAtmosphere(class UWorld* World);
@@ -28,11 +47,20 @@ private:
 	class AExponentialHeightFog* SpawnExponentialHeightFog(class UWorld* World);
 	class AStaticMeshActor* SpawnPlaneActor(class UWorld* World);
 	class AWarriorPurpleCharacter* SpawnWarriorPurpleCharacter(class UWorld* World, const FVector& Location);
+	bool SpawnWarriorGrid(class UWorld* World, const FStressSettings& Stress, bool bForPlay, TArray<class AWarriorCharacter*>& OutWarriors);
+	void ScaleGroundToWarriorGrid(class AStaticMeshActor* PlaneActor, const FStressSettings& Stress) const;
+	FVector GetWarriorGridLocation(int32 Index, const FStressSettings& Stress) const;
+
+	// Stress benchmark: ticks the warrior grid in a game world with scripted input
+	bool ParseStressSettings(const FString& Params, FStressSettings& OutStress) const;
+	bool RunStressBenchmark(const FStressSettings& Stress);
+	bool WriteStressReport(const FStressSettings& Stress, const TArray<double>& FrameMs, double BaselineMs, double TickUsPerWarrior,
+		double FlipbookChangesPerFrame, int64 WarriorBytes) const;
 	
 	// Utility
 	void PrintUsage() const;
-	void PrintSuccess(const FString& MapName, const FString& PackagePath) const;
+	void PrintSuccess(const FString& MapName, const FString& PackagePath, const FStressSettings& Stress) const;
 	void PrintFailure(const FString& MapName) const;
-	void PrintDryRunSummary(const FString& MapName, const FString& OutputPath) const;
+	void PrintDryRunSummary(const FString& MapName, const FString& OutputPath, const FStressSettings& Stress) const;
 	bool ValidateAndSanitizePath(FString& Path) const;
 };
\ No newline at end of file
@@ -1,5 +1,10 @@
 #include "MyGameMode.h"
 #include "WarriorPurpleCharacter.h"
+#include "WarriorBlueCharacter.h"
+#include "WarriorRedCharacter.h"
+#include "Engine/AssetManager.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "HAL/PlatformTime.h"
 #include "Engine/Engine.h"
 #include "Kismet/GameplayStatics.h"
 
@@ -24,6 +29,10 @@ AMyGameMode::AMyGameMode()
     {
         UE_LOG(LogTemp, Warning, TEXT("MyGameMode: Default Pawn Class is %s"), *DefaultPawnClass->GetName());
     }
+
+    PreloadWarriorClasses.Add(AWarriorBlueCharacter::StaticClass());
+    PreloadWarriorClasses.Add(AWarriorPurpleCharacter::StaticClass());
+    PreloadWarriorClasses.Add(AWarriorRedCharacter::StaticClass());
 }
 
 void AMyGameMode::BeginPlay()
@@ -49,4 +58,157 @@ void AMyGameMode::InitGameState()
     
     // Additional initialization if needed
     UE_LOG(LogTemp, Warning, TEXT("MyGameMode: Game state initialized"));
+
+    PreloadWarriorAssets();
+}
+
+void AMyGameMode::PreloadWarriorAssets()
+{
+    PreloadingClasses.Reset();
+    for (const TSubclassOf<AWarriorCharacter>& WarriorClass : PreloadWarriorClasses)
+    {
+        if (WarriorClass && !AWarriorCharacter::AreClassAssetsResolved(WarriorClass))
+        {
+            PreloadingClasses.AddUnique(WarriorClass);
+        }
+    }
+
+    UClass* PawnClass = DefaultPawnClass;
+    if (PawnClass && PawnClass->IsChildOf(AWarriorCharacter::StaticClass()) && !AWarriorCharacter::AreClassAssetsResolved(PawnClass))
+    {
+        PreloadingClasses.AddUnique(PawnClass);
+    }
+
+    TArray<FSoftObjectPath> RootPaths;
+    for (const TSubclassOf<AWarriorCharacter>& WarriorClass : PreloadingClasses)
+    {
+        AWarriorCharacter::GetPreloadPaths(WarriorClass, RootPaths);
+    }
+
+    PreloadManifest.Reset();
+    BuildPreloadManifest(RootPaths, PreloadManifest);
+
+    // Set before requesting: the completion delegate can run inside RequestAsyncLoad when everything is already loaded
+    bWarriorPreloadPending = true;
+    PreloadStartTime = FPlatformTime::Seconds();
+
+    if (PreloadManifest.Num() == 0)
+    {
+        OnWarriorAssetsPreloaded();
+        return;
+    }
+
+    WarriorPreloadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+        PreloadManifest, FStreamableDelegate::CreateUObject(this, &AMyGameMode::OnWarriorAssetsPreloaded));
+}
+
+void AMyGameMode::BuildPreloadManifest(const TArray<FSoftObjectPath>& RootPaths, TArray<FSoftObjectPath>& OutPaths) const
+{
+    IAssetRegistry* AssetRegistry = IAssetRegistry::Get();
+    if (!AssetRegistry || AssetRegistry->IsLoadingAssets())
+    {
+        UE_LOG(LogTemp, Log, TEXT("MyGameMode: Asset registry not ready, preloading %d root assets only"), RootPaths.Num());
+        OutPaths = RootPaths;
+        return;
+    }
+
+    // Hard package dependencies are exactly what loading the roots would pull in
+    TSet<FName> Packages;
+    TArray<FName> PendingPackages;
+    for (const FSoftObjectPath& RootPath : RootPaths)
+    {
+        PendingPackages.Add(RootPath.GetLongPackageFName());
+    }
+
+    while (PendingPackages.Num() > 0)
+    {
+        const FName PackageName = PendingPackages.Pop(EAllowShrinking::No);
+        bool bAlreadyVisited = false;
+        Packages.Add(PackageName, &bAlreadyVisited);
+        if (bAlreadyVisited)
+        {
+            continue;
+        }
+
+        TArray<FName> Dependencies;
+        AssetRegistry->GetDependencies(PackageName, Dependencies, UE::AssetRegistry::EDependencyCategory::Package, UE::AssetRegistry::EDependencyQuery::Hard);
+        for (const FName Dependency : Dependencies)
+        {
+            // Engine and script packages are resident already
+            if (Dependency.ToString().StartsWith(TEXT("/Game/")))
+            {
+                PendingPackages.Add(Dependency);
+            }
+        }
+    }
+
+    TMap<FString, int32> AssetsByClass;
+    for (const FName PackageName : Packages)
+    {
+        TArray<FAssetData> PackageAssets;
+        AssetRegistry->GetAssetsByPackageName(PackageName, PackageAssets);
+        for (const FAssetData& Asset : PackageAssets)
+        {
+            OutPaths.Add(Asset.GetSoftObjectPath());
+            AssetsByClass.FindOrAdd(Asset.AssetClassPath.GetAssetName().ToString())++;
+        }
+    }
+
+    FString Breakdown;
+    for (const TPair<FString, int32>& Entry : AssetsByClass)
+    {
+        Breakdown += FString::Printf(TEXT("%s%s=%d"), Breakdown.IsEmpty() ? TEXT("") : TEXT(", "), *Entry.Key, Entry.Value);
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("MyGameMode: Preload manifest for %d warrior classes: %d packages, %d assets (%s)"),
+        PreloadingClasses.Num(), Packages.Num(), OutPaths.Num(), *Breakdown);
+}
+
+void AMyGameMode::HandleStartingNewPlayer_Implementation(APlayerController* NewPlayer)
+{
+    if (bWarriorPreloadPending)
+    {
+        UE_LOG(LogTemp, Log, TEXT("MyGameMode: Holding %s until warrior assets are loaded"), *GetNameSafe(NewPlayer));
+        PlayersAwaitingPreload.Add(NewPlayer);
+        return;
+    }
+
+    Super::HandleStartingNewPlayer_Implementation(NewPlayer);
+}
+
+void AMyGameMode::OnWarriorAssetsPreloaded()
+{
+    // A warrior that spawned before this point resolved its class synchronously already
+    for (const TSubclassOf<AWarriorCharacter>& WarriorClass : PreloadingClasses)
+    {
+        if (!AWarriorCharacter::AreClassAssetsResolved(WarriorClass))
+        {
+            AWarriorCharacter::ResolveClassAssets(WarriorClass, false);
+        }
+    }
+
+    int64 LoadedBytes = 0;
+    for (const FSoftObjectPath& AssetPath : PreloadManifest)
+    {
+        if (const UObject* Asset = AssetPath.ResolveObject())
+        {
+            LoadedBytes += Asset->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+        }
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("MyGameMode: Warrior assets preloaded for %d classes: %d assets, %.2f MB in %.1f ms"),
+        PreloadingClasses.Num(), PreloadManifest.Num(), LoadedBytes / (1024.0 * 1024.0), (FPlatformTime::Seconds() - PreloadStartTime) * 1000.0);
+    PreloadingClasses.Reset();
+    PreloadManifest.Reset();
+    bWarriorPreloadPending = false;
+
+    // Release the players that joined meanwhile, in join order
+    TArray<TWeakObjectPtr<APlayerController>> ReleasedPlayers = MoveTemp(PlayersAwaitingPreload);
+    for (const TWeakObjectPtr<APlayerController>& Player : ReleasedPlayers)
+    {
+        if (Player.IsValid())
+        {
+            Super::HandleStartingNewPlayer_Implementation(Player.Get());
+        }
+    }
 }
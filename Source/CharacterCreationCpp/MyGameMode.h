@@ -2,8 +2,11 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/GameModeBase.h"
+#include "Engine/StreamableManager.h"
 #include "MyGameMode.generated.h"
 
+class AWarriorCharacter;
+
 /**
  * Custom game mode that uses WarriorPurpleCharacter as the default pawn
  */
@@ -21,4 +24,40 @@ public:
 protected:
     /** Override to specify the default pawn class */
     virtual void InitGameState() override;
+
+    /** Holds new players until the warrior preload finished, so their pawn never spawns on a blocking load */
+    virtual void HandleStartingNewPlayer_Implementation(APlayerController* NewPlayer) override;
+
+    /** Warrior classes whose assets are loaded asynchronously before any of them spawns; the default pawn is always included */
+    UPROPERTY(EditDefaultsOnly, Category = "Preload")
+    TArray<TSubclassOf<AWarriorCharacter>> PreloadWarriorClasses;
+
+private:
+    /** Start the async load of every preloaded warrior class's assets */
+    void PreloadWarriorAssets();
+
+    /**
+     * Expand the classes' root references into every package they pull in - animation sets,
+     * flipbooks, sprites, textures, materials and input assets - using the asset registry's hard
+     * dependencies. Returns the roots alone while the registry is still scanning.
+     */
+    void BuildPreloadManifest(const TArray<FSoftObjectPath>& RootPaths, TArray<FSoftObjectPath>& OutPaths) const;
+
+    /** Resolve each preloaded class once its assets are in memory */
+    void OnWarriorAssetsPreloaded();
+
+    /** Classes the running preload covers */
+    TArray<TSubclassOf<AWarriorCharacter>> PreloadingClasses;
+
+    /** Keeps the preloaded assets alive for as long as the game mode */
+    TSharedPtr<FStreamableHandle> WarriorPreloadHandle;
+
+    /** Everything the running preload requested, for the byte count once it completes */
+    TArray<FSoftObjectPath> PreloadManifest;
+
+    /** Players that joined while the preload was running */
+    TArray<TWeakObjectPtr<APlayerController>> PlayersAwaitingPreload;
+
+    bool bWarriorPreloadPending = false;
+    double PreloadStartTime = 0.0;
 };
@@ -0,0 +1,439 @@
+#include "SpriteBenchmarkCommandlet.h"
+#include "SpriteBenchmarkLog.h"
+#include "CharacterCreationCommandlet/SpriteSheetProcessor.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "Math/RandomStream.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Modules/ModuleManager.h"
+#include "UObject/GarbageCollection.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectHash.h"
+
+USpriteBenchmarkCommandlet::USpriteBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+	ShowErrorCount = true;
+	HelpDescription = TEXT("Benchmark the sprite sheet pipeline on generated sheets");
+	HelpUsage = TEXT("SpriteBenchmarkCommandlet [-columns=<N>] [-rows=<N>] [-cellsize=<Pixels>] [-format=bgra8|rgba16|gray8] [-iterations=<N>] [-warmup=<N>] [-seed=<N>] [-atlas] [-notrim] [-concurrentsave] [-keep] [-report=<Path>]");
+}
+
+int32 USpriteBenchmarkCommandlet::Main(const FString& Params)
+{
+	UE_LOG(LogSpriteBenchmark, Display, TEXT("=== Sprite Benchmark Commandlet Started ==="));
+
+	if (FParse::Param(*Params, TEXT("help")))
+	{
+		PrintUsage();
+		return 0;
+	}
+
+	FBenchmarkSettings Settings;
+	if (!ParseSettings(Params, Settings))
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	USpriteSheetProcessor::PreloadDecoderModules();
+
+	FString PngPath;
+	if (!WriteSyntheticSheet(Settings, PngPath))
+	{
+		return 1;
+	}
+
+	UE_LOG(LogSpriteBenchmark, Display, TEXT("Sheet: %dx%d cells of %dpx, %s, atlas %s, trim %s, %d+%d iterations, seed %d"),
+		Settings.Columns, Settings.Rows, Settings.CellSize, GetFormatName(Settings.Format),
+		Settings.bUseSheetAtlas ? TEXT("on") : TEXT("off"), Settings.bTrimFrames ? TEXT("on") : TEXT("off"),
+		Settings.WarmupIterations, Settings.Iterations, Settings.Seed);
+
+	FSpritePipelineProfiler::Get().Reset();
+
+	TArray<FIterationResult> Results;
+	Results.Reserve(Settings.Iterations);
+	int32 NumFailed = 0;
+
+	const int32 TotalIterations = Settings.WarmupIterations + Settings.Iterations;
+	for (int32 Iteration = 0; Iteration < TotalIterations; Iteration++)
+	{
+		// Fixed-width numbers keep one iteration's name from being a prefix of another's
+		const FString SheetName = FString::Printf(TEXT("SpriteBench%04d"), Iteration);
+
+		FIterationResult Result;
+		RunIteration(Settings, PngPath, SheetName, Result);
+		CleanUpSheetAssets(SheetName, !Settings.bKeepAssets);
+
+		const bool bWarmup = Iteration < Settings.WarmupIterations;
+		UE_LOG(LogSpriteBenchmark, Display, TEXT("%s %d: %.2f ms%s"), bWarmup ? TEXT("Warmup") : TEXT("Iteration"),
+			bWarmup ? Iteration : Iteration - Settings.WarmupIterations, Result.TotalMs, Result.bSuccess ? TEXT("") : TEXT(" (FAILED)"));
+
+		NumFailed += Result.bSuccess ? 0 : 1;
+		if (!bWarmup)
+		{
+			Results.Add(Result);
+		}
+	}
+
+	const uint64 PeakUsedPhysical = FPlatformMemory::GetStats().PeakUsedPhysical;
+	PrintReport(Settings, Results, PeakUsedPhysical);
+
+	FString ReportPath;
+	if (FParse::Value(*Params, TEXT("report="), ReportPath)
+		&& !WriteJsonReport(FPaths::ConvertRelativePathToFull(ReportPath), Settings, Results, PeakUsedPhysical))
+	{
+		return 1;
+	}
+
+	if (NumFailed > 0)
+	{
+		UE_LOG(LogSpriteBenchmark, Error, TEXT("=== Sprite Benchmark Failed: %d of %d iterations did not complete ==="), NumFailed, TotalIterations);
+		return 1;
+	}
+
+	UE_LOG(LogSpriteBenchmark, Display, TEXT("=== Sprite Benchmark Completed ==="));
+	return 0;
+}
+
+bool USpriteBenchmarkCommandlet::ParseSettings(const FString& Params, FBenchmarkSettings& OutSettings) const
+{
+	FParse::Value(*Params, TEXT("columns="), OutSettings.Columns);
+	FParse::Value(*Params, TEXT("rows="), OutSettings.Rows);
+	FParse::Value(*Params, TEXT("cellsize="), OutSettings.CellSize);
+	FParse::Value(*Params, TEXT("iterations="), OutSettings.Iterations);
+	FParse::Value(*Params, TEXT("warmup="), OutSettings.WarmupIterations);
+	FParse::Value(*Params, TEXT("seed="), OutSettings.Seed);
+	OutSettings.bUseSheetAtlas = FParse::Param(*Params, TEXT("atlas"));
+	OutSettings.bTrimFrames = !FParse::Param(*Params, TEXT("notrim"));
+	OutSettings.bConcurrentSave = FParse::Param(*Params, TEXT("concurrentsave"));
+	OutSettings.bKeepAssets = FParse::Param(*Params, TEXT("keep"));
+
+	FString FormatName;
+	if (FParse::Value(*Params, TEXT("format="), FormatName) && !ParseFormat(FormatName, OutSettings.Format))
+	{
+		UE_LOG(LogSpriteBenchmark, Error, TEXT("Unknown pixel format: %s"), *FormatName);
+		return false;
+	}
+
+	if (OutSettings.Columns <= 0 || OutSettings.Columns > MaxGridDimension || OutSettings.Rows <= 0 || OutSettings.Rows > MaxGridDimension)
+	{
+		UE_LOG(LogSpriteBenchmark, Error, TEXT("Invalid grid dimensions: columns=%d, rows=%d (valid range: 1-%d)"),
+			OutSettings.Columns, OutSettings.Rows, MaxGridDimension);
+		return false;
+	}
+
+	if (OutSettings.CellSize <= 0 || OutSettings.CellSize > MaxCellSize)
+	{
+		UE_LOG(LogSpriteBenchmark, Error, TEXT("Invalid cell size: %d (valid range: 1-%d)"), OutSettings.CellSize, MaxCellSize);
+		return false;
+	}
+
+	if (OutSettings.Iterations <= 0 || OutSettings.Iterations > MaxIterations || OutSettings.WarmupIterations < 0 || OutSettings.WarmupIterations > MaxIterations)
+	{
+		UE_LOG(LogSpriteBenchmark, Error, TEXT("Invalid iteration counts: iterations=%d, warmup=%d (valid range: 1-%d, 0-%d)"),
+			OutSettings.Iterations, OutSettings.WarmupIterations, MaxIterations, MaxIterations);
+		return false;
+	}
+
+	return true;
+}
+
+bool USpriteBenchmarkCommandlet::ParseFormat(const FString& Name, ESheetFormat& OutFormat)
+{
+	for (ESheetFormat Format : { ESheetFormat::BGRA8, ESheetFormat::RGBA16, ESheetFormat::Gray8 })
+	{
+		if (Name.Equals(GetFormatName(Format), ESearchCase::IgnoreCase))
+		{
+			OutFormat = Format;
+			return true;
+		}
+	}
+	return false;
+}
+
+const TCHAR* USpriteBenchmarkCommandlet::GetFormatName(ESheetFormat Format)
+{
+	switch (Format)
+	{
+	case ESheetFormat::RGBA16:	return TEXT("rgba16");
+	case ESheetFormat::Gray8:	return TEXT("gray8");
+	default:					return TEXT("bgra8");
+	}
+}
+
+bool USpriteBenchmarkCommandlet::WriteSyntheticSheet(const FBenchmarkSettings& Settings, FString& OutPngPath) const
+{
+	const int32 Width = Settings.Columns * Settings.CellSize;
+	const int32 Height = Settings.Rows * Settings.CellSize;
+
+	// Each cell holds a striped rectangle inset by a random margin: every frame is unique, trimming
+	// has transparent borders to remove, and the PNG compresses roughly like real pixel art
+	TArray64<uint8> Pixels;
+	Pixels.SetNumZeroed(int64(Width) * Height * 4);
+
+	FRandomStream Stream(Settings.Seed);
+	for (int32 Row = 0; Row < Settings.Rows; Row++)
+	{
+		for (int32 Col = 0; Col < Settings.Columns; Col++)
+		{
+			const int32 Margin = Stream.RandRange(0, Settings.CellSize / 4);
+			const int32 StripeWidth = Stream.RandRange(1, 8);
+			const FColor Colors[2] = {
+				FColor(Stream.RandRange(0, 255), Stream.RandRange(0, 255), Stream.RandRange(0, 255), 255),
+				FColor(Stream.RandRange(0, 255), Stream.RandRange(0, 255), Stream.RandRange(0, 255), 255)
+			};
+
+			for (int32 Y = Margin; Y < Settings.CellSize - Margin; Y++)
+			{
+				uint8* Pixel = &Pixels[(int64(Row * Settings.CellSize + Y) * Width + Col * Settings.CellSize + Margin) * 4];
+				for (int32 X = Margin; X < Settings.CellSize - Margin; X++, Pixel += 4)
+				{
+					const FColor& Color = Colors[((X + Y) / StripeWidth) & 1];
+					Pixel[0] = Color.B;
+					Pixel[1] = Color.G;
+					Pixel[2] = Color.R;
+					Pixel[3] = Color.A;
+				}
+			}
+		}
+	}
+
+	// The pipeline always decodes to BGRA8; other formats measure the cost of getting there
+	TArray64<uint8> RawData;
+	ERGBFormat RawFormat = ERGBFormat::BGRA;
+	int32 BitDepth = 8;
+	switch (Settings.Format)
+	{
+	case ESheetFormat::RGBA16:
+	{
+		RawFormat = ERGBFormat::RGBA;
+		BitDepth = 16;
+		RawData.SetNumUninitialized(Pixels.Num() * 2);
+		uint16* Out = reinterpret_cast<uint16*>(RawData.GetData());
+		for (int64 Index = 0; Index < Pixels.Num(); Index += 4, Out += 4)
+		{
+			Out[0] = Pixels[Index + 2] * 257;
+			Out[1] = Pixels[Index + 1] * 257;
+			Out[2] = Pixels[Index + 0] * 257;
+			Out[3] = Pixels[Index + 3] * 257;
+		}
+		break;
+	}
+	case ESheetFormat::Gray8:
+	{
+		// No alpha, so trimming finds nothing to remove
+		RawFormat = ERGBFormat::Gray;
+		RawData.SetNumUninitialized(Pixels.Num() / 4);
+		for (int64 Index = 0; Index < RawData.Num(); Index++)
+		{
+			const uint8* Pixel = &Pixels[Index * 4];
+			RawData[Index] = static_cast<uint8>((Pixel[0] * 29 + Pixel[1] * 150 + Pixel[2] * 77) >> 8);
+		}
+		break;
+	}
+	default:
+		RawData = MoveTemp(Pixels);
+		break;
+	}
+
+	IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+	TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::PNG);
+	if (!ImageWrapper.IsValid() || !ImageWrapper->SetRaw(RawData.GetData(), RawData.Num(), Width, Height, RawFormat, BitDepth))
+	{
+		UE_LOG(LogSpriteBenchmark, Error, TEXT("Failed to encode the %dx%d %s benchmark sheet"), Width, Height, GetFormatName(Settings.Format));
+		return false;
+	}
+
+	const TArray64<uint8> Compressed = ImageWrapper->GetCompressed();
+	OutPngPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("SpriteBenchmark"), FString::Printf(TEXT("SpriteBench_%dx%d_%d_%s_%d.png"),
+		Settings.Columns, Settings.Rows, Settings.CellSize, GetFormatName(Settings.Format), Settings.Seed));
+	if (!FFileHelper::SaveArrayToFile(Compressed, *OutPngPath))
+	{
+		UE_LOG(LogSpriteBenchmark, Error, TEXT("Failed to write benchmark sheet: %s"), *OutPngPath);
+		return false;
+	}
+
+	UE_LOG(LogSpriteBenchmark, Display, TEXT("Generated %s (%lld bytes)"), *OutPngPath, Compressed.Num());
+	return true;
+}
+
+bool USpriteBenchmarkCommandlet::RunIteration(const FBenchmarkSettings& Settings, const FString& PngPath, const FString& SheetName, FIterationResult& OutResult)
+{
+	const FSpritePipelineProfiler& Profiler = FSpritePipelineProfiler::Get();
+	uint64 CyclesBefore[static_cast<int32>(ESpritePipelineStage::Count)];
+	for (int32 Stage = 0; Stage < static_cast<int32>(ESpritePipelineStage::Count); Stage++)
+	{
+		CyclesBefore[Stage] = Profiler.GetStageCycles(static_cast<ESpritePipelineStage>(Stage));
+	}
+
+	FSpriteSheetInfo SpriteInfo;
+	SpriteInfo.Columns = Settings.Columns;
+	SpriteInfo.Rows = Settings.Rows;
+	SpriteInfo.bUseSheetAtlas = Settings.bUseSheetAtlas;
+	SpriteInfo.bTrimFrames = Settings.bTrimFrames;
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	// A fresh processor per iteration, so no frame is shared with an earlier iteration's sprites
+	FDecodedSpriteSheet DecodedSheet;
+	DecodedSheet.TextureName = SheetName;
+	OutResult.bSuccess = USpriteSheetProcessor::DecodeSpriteSheet(PngPath, SpriteInfo, DecodedSheet);
+	if (OutResult.bSuccess)
+	{
+		USpriteSheetProcessor* Processor = NewObject<USpriteSheetProcessor>(GetTransientPackage());
+		Processor->bConcurrentSave = Settings.bConcurrentSave;
+		OutResult.bSuccess = Processor->ProcessDecodedSpriteSheet(SheetName, DecodedSheet, SpriteInfo);
+	}
+
+	OutResult.TotalMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	OutResult.Sprites = OutResult.bSuccess ? Settings.Columns * Settings.Rows : 0;
+	for (int32 Stage = 0; Stage < static_cast<int32>(ESpritePipelineStage::Count); Stage++)
+	{
+		OutResult.StageMs[Stage] = FPlatformTime::ToMilliseconds64(Profiler.GetStageCycles(static_cast<ESpritePipelineStage>(Stage)) - CyclesBefore[Stage]);
+	}
+
+	return OutResult.bSuccess;
+}
+
+void USpriteBenchmarkCommandlet::CleanUpSheetAssets(const FString& SheetName, bool bDeleteFiles) const
+{
+	// Sprites, textures, flipbooks and the animation set all carry the sheet name
+	TArray<UPackage*> Packages;
+	ForEachObjectOfClass(UPackage::StaticClass(), [&Packages, &SheetName](UObject* Object)
+	{
+		if (Object->GetName().Contains(SheetName))
+		{
+			Packages.Add(CastChecked<UPackage>(Object));
+		}
+	}, false);
+
+	for (UPackage* Package : Packages)
+	{
+		ForEachObjectWithPackage(Package, [](UObject* Object)
+		{
+			Object->ClearFlags(RF_Standalone);
+			return true;
+		}, false);
+
+		FString Filename;
+		if (bDeleteFiles && FPackageName::TryConvertLongPackageNameToFilename(Package->GetName(), Filename, FPackageName::GetAssetPackageExtension()))
+		{
+			IFileManager::Get().Delete(*Filename, false, true, true);
+		}
+	}
+
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+}
+
+void USpriteBenchmarkCommandlet::PrintReport(const FBenchmarkSettings& Settings, const TArray<FIterationResult>& Results, uint64 PeakUsedPhysical) const
+{
+	TArray<double> TotalSamples;
+	double TotalSeconds = 0.0;
+	int64 TotalSprites = 0;
+	for (const FIterationResult& Result : Results)
+	{
+		TotalSamples.Add(Result.TotalMs);
+		TotalSeconds += Result.TotalMs / 1000.0;
+		TotalSprites += Result.Sprites;
+	}
+
+	UE_LOG(LogSpriteBenchmark, Display, TEXT("%-16s %10s %10s %10s"), TEXT("Stage (ms)"), TEXT("p50"), TEXT("p90"), TEXT("max"));
+	for (int32 Stage = 0; Stage < static_cast<int32>(ESpritePipelineStage::Count); Stage++)
+	{
+		TArray<double> StageSamples;
+		for (const FIterationResult& Result : Results)
+		{
+			StageSamples.Add(Result.StageMs[Stage]);
+		}
+		UE_LOG(LogSpriteBenchmark, Display, TEXT("%-16s %10.2f %10.2f %10.2f"), FSpritePipelineProfiler::GetStageName(static_cast<ESpritePipelineStage>(Stage)),
+			FPerformanceReport::GetPercentile(StageSamples, 50.0), FPerformanceReport::GetPercentile(StageSamples, 90.0), FPerformanceReport::GetPercentile(StageSamples, 100.0));
+	}
+	UE_LOG(LogSpriteBenchmark, Display, TEXT("%-16s %10.2f %10.2f %10.2f"), TEXT("Total"),
+		FPerformanceReport::GetPercentile(TotalSamples, 50.0), FPerformanceReport::GetPercentile(TotalSamples, 90.0), FPerformanceReport::GetPercentile(TotalSamples, 100.0));
+
+	UE_LOG(LogSpriteBenchmark, Display, TEXT("%.1f sprites/s, peak RSS %.1f MB"),
+		TotalSeconds > 0.0 ? TotalSprites / TotalSeconds : 0.0, PeakUsedPhysical / (1024.0 * 1024.0));
+}
+
+bool USpriteBenchmarkCommandlet::WriteJsonReport(const FString& ReportPath, const FBenchmarkSettings& Settings, const TArray<FIterationResult>& Results, uint64 PeakUsedPhysical) const
+{
+	TSharedRef<FJsonObject> Root = FPerformanceReport::MakeRoot(1);
+	Root->SetStringField(TEXT("Engine"), FEngineVersion::Current().ToString());
+	Root->SetNumberField(TEXT("ProcessorVersion"), USpriteSheetProcessor::ProcessorVersion);
+
+	TSharedRef<FJsonObject> SettingsObject = MakeShared<FJsonObject>();
+	SettingsObject->SetNumberField(TEXT("Columns"), Settings.Columns);
+	SettingsObject->SetNumberField(TEXT("Rows"), Settings.Rows);
+	SettingsObject->SetNumberField(TEXT("CellSize"), Settings.CellSize);
+	SettingsObject->SetStringField(TEXT("Format"), GetFormatName(Settings.Format));
+	SettingsObject->SetNumberField(TEXT("Iterations"), Settings.Iterations);
+	SettingsObject->SetNumberField(TEXT("Warmup"), Settings.WarmupIterations);
+	SettingsObject->SetNumberField(TEXT("Seed"), Settings.Seed);
+	SettingsObject->SetBoolField(TEXT("Atlas"), Settings.bUseSheetAtlas);
+	SettingsObject->SetBoolField(TEXT("Trim"), Settings.bTrimFrames);
+	SettingsObject->SetBoolField(TEXT("ConcurrentSave"), Settings.bConcurrentSave);
+	Root->SetObjectField(TEXT("Settings"), SettingsObject);
+
+	TArray<double> TotalSamples;
+	double TotalSeconds = 0.0;
+	int64 TotalSprites = 0;
+	int32 NumFailed = 0;
+	for (const FIterationResult& Result : Results)
+	{
+		TotalSamples.Add(Result.TotalMs);
+		TotalSeconds += Result.TotalMs / 1000.0;
+		TotalSprites += Result.Sprites;
+		NumFailed += Result.bSuccess ? 0 : 1;
+	}
+	Root->SetObjectField(TEXT("TotalMs"), FPerformanceReport::MakePercentiles(TotalSamples, 90));
+
+	TSharedRef<FJsonObject> StagesObject = MakeShared<FJsonObject>();
+	for (int32 Stage = 0; Stage < static_cast<int32>(ESpritePipelineStage::Count); Stage++)
+	{
+		TArray<double> StageSamples;
+		for (const FIterationResult& Result : Results)
+		{
+			StageSamples.Add(Result.StageMs[Stage]);
+		}
+		StagesObject->SetObjectField(FSpritePipelineProfiler::GetStageName(static_cast<ESpritePipelineStage>(Stage)), FPerformanceReport::MakePercentiles(StageSamples, 90));
+	}
+	Root->SetObjectField(TEXT("StageMs"), StagesObject);
+
+	Root->SetNumberField(TEXT("SpritesPerSecond"), TotalSeconds > 0.0 ? TotalSprites / TotalSeconds : 0.0);
+	Root->SetNumberField(TEXT("PeakUsedPhysicalBytes"), static_cast<double>(PeakUsedPhysical));
+	Root->SetNumberField(TEXT("FailedIterations"), NumFailed);
+
+	if (!FPerformanceReport::Write(Root, ReportPath))
+	{
+		UE_LOG(LogSpriteBenchmark, Error, TEXT("Failed to write benchmark report: %s"), *ReportPath);
+		return false;
+	}
+
+	UE_LOG(LogSpriteBenchmark, Display, TEXT("Wrote benchmark report: %s"), *ReportPath);
+	return true;
+}
+
+void USpriteBenchmarkCommandlet::PrintUsage() const
+{
+	UE_LOG(LogSpriteBenchmark, Display, TEXT("Usage: %s"), *HelpUsage);
+	UE_LOG(LogSpriteBenchmark, Display, TEXT("  -columns=<N> -rows=<N>           Grid of the generated sheet (default 6x8)"));
+	UE_LOG(LogSpriteBenchmark, Display, TEXT("  -cellsize=<Pixels>               Cell edge length (default 192)"));
+	UE_LOG(LogSpriteBenchmark, Display, TEXT("  -format=bgra8|rgba16|gray8       PNG pixel format of the generated sheet (default bgra8)"));
+	UE_LOG(LogSpriteBenchmark, Display, TEXT("  -iterations=<N> -warmup=<N>      Measured and discarded passes (default 5 and 1)"));
+	UE_LOG(LogSpriteBenchmark, Display, TEXT("  -seed=<N>                        Seed of the sheet contents; keep it fixed to compare runs"));
+	UE_LOG(LogSpriteBenchmark, Display, TEXT("  -atlas -notrim -concurrentsave   Same as the CharacterCreationCommandlet switches"));
+	UE_LOG(LogSpriteBenchmark, Display, TEXT("  -keep                            Keep the generated assets on disk"));
+	UE_LOG(LogSpriteBenchmark, Display, TEXT("  -report=<Path>                   Write percentiles, sprites/s and peak RSS as JSON"));
+}
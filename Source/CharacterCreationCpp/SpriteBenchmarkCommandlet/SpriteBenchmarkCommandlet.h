@@ -0,0 +1,74 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "CharacterCreationCommandlet/SpritePipelineProfiler.h"
+#include "SpriteBenchmarkCommandlet.generated.h"
+
+/**
+ * Measures USpriteSheetProcessor throughput on procedurally generated sheets, so results do not
+ * depend on the PNGs in RawAssets and can be compared across commits in headless CI runs.
+ */
+UCLASS()
+class CHARACTERCREATIONCPP_API USpriteBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	USpriteBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+	static constexpr int32 MaxIterations = 1000;
+	static constexpr int32 MaxGridDimension = 100;
+	static constexpr int32 MaxCellSize = 1024;
+
+private:
+	enum class ESheetFormat : uint8
+	{
+		BGRA8,
+		RGBA16,
+		Gray8
+	};
+
+	struct FBenchmarkSettings
+	{
+		int32 Columns = 6;
+		int32 Rows = 8;
+		int32 CellSize = 192;
+		ESheetFormat Format = ESheetFormat::BGRA8;
+		int32 Iterations = 5;
+		int32 WarmupIterations = 1;
+		int32 Seed = 1234;
+		bool bUseSheetAtlas = false;
+		bool bTrimFrames = true;
+		bool bConcurrentSave = false;
+		bool bKeepAssets = false;
+	};
+
+	// One measured import -> extract -> animate -> save pass
+	struct FIterationResult
+	{
+		double TotalMs = 0.0;
+		double StageMs[static_cast<int32>(ESpritePipelineStage::Count)] = {};
+		int32 Sprites = 0;
+		bool bSuccess = false;
+	};
+
+	bool ParseSettings(const FString& Params, FBenchmarkSettings& OutSettings) const;
+	static bool ParseFormat(const FString& Name, ESheetFormat& OutFormat);
+	static const TCHAR* GetFormatName(ESheetFormat Format);
+
+	// Writes a deterministic PNG sheet for Settings and returns its path
+	bool WriteSyntheticSheet(const FBenchmarkSettings& Settings, FString& OutPngPath) const;
+
+	bool RunIteration(const FBenchmarkSettings& Settings, const FString& PngPath, const FString& SheetName, FIterationResult& OutResult);
+
+	// Unloads and deletes every asset an iteration created, so iterations start from the same state
+	void CleanUpSheetAssets(const FString& SheetName, bool bDeleteFiles) const;
+
+	void PrintReport(const FBenchmarkSettings& Settings, const TArray<FIterationResult>& Results, uint64 PeakUsedPhysical) const;
+	bool WriteJsonReport(const FString& ReportPath, const FBenchmarkSettings& Settings, const TArray<FIterationResult>& Results, uint64 PeakUsedPhysical) const;
+
+	void PrintUsage() const;
+};
@@ -0,0 +1,3 @@
+#include "SpriteBenchmarkLog.h"
+
+DEFINE_LOG_CATEGORY(LogSpriteBenchmark);
\ No newline at end of file
@@ -12,7 +12,4 @@ class CHARACTERCREATIONCPP_API AWarriorBlueCharacter : public AWarriorCharacter
 
 public:
 	AWarriorBlueCharacter();
-
-protected:
-	virtual void LoadAnimations() override;
 };
@@ -0,0 +1,229 @@
+#include "WarriorCrowdComponent.h"
+#include "CharacterCreationCommandlet/WarriorCharacter.h"
+#include "CharacterCreationCommandlet/SpritePalette.h"
+#include "PaperFlipbook.h"
+#include "PaperSprite.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Algo/Count.h"
+
+UWarriorCrowdComponent::UWarriorCrowdComponent()
+{
+    PrimaryComponentTick.bCanEverTick = true;
+    PrimaryComponentTick.bStartWithTickEnabled = true;
+
+    bRandomizeStartTime = true;
+}
+
+void UWarriorCrowdComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    if (WarriorClass && Animations.Num() == 0)
+    {
+        BuildClips();
+    }
+}
+
+void UWarriorCrowdComponent::SetWarriorClass(TSubclassOf<AWarriorCharacter> NewWarriorClass)
+{
+    WarriorClass = NewWarriorClass;
+    BuildClips();
+
+    for (int32 Index = 0; Index < FMath::Min(Members.Num(), PerInstanceSpriteData.Num()); Index++)
+    {
+        PerInstanceSpriteData[Index].SourceSprite = GetFirstFrame(Members[Index].Animation);
+        Members[Index].Frame = INDEX_NONE;
+    }
+    MarkRenderStateDirty();
+}
+
+void UWarriorCrowdComponent::BuildClips()
+{
+    UTexture2D* PaletteTexture = nullptr;
+    UMaterialInterface* PaletteMaterial = nullptr;
+    TArray<UPaperFlipbook*> ClassAnimations;
+    TArray<bool> ClassLooping;
+    AWarriorCharacter::GetClassAssets(WarriorClass, ClassAnimations, ClassLooping, PaletteTexture, PaletteMaterial);
+
+    Animations.Reset(NumAnimationTypes);
+    for (int32 Index = 0; Index < NumAnimationTypes; Index++)
+    {
+        UPaperFlipbook* Flipbook = ClassAnimations[Index];
+        Animations.Add(Flipbook);
+
+        FCrowdClip& Clip = Clips[Index];
+        Clip.Frames.Reset();
+        Clip.bLooping = ClassLooping[Index];
+        Clip.FramesPerSecond = Flipbook ? Flipbook->GetFramesPerSecond() : 0.0f;
+        if (Flipbook)
+        {
+            // GetSpriteAtFrame walks the key frames; do it once here rather than per member per tick
+            const int32 NumFrames = Flipbook->GetNumFrames();
+            Clip.Frames.Reserve(NumFrames);
+            for (int32 Frame = 0; Frame < NumFrames; Frame++)
+            {
+                Clip.Frames.Add(Flipbook->GetSpriteAtFrame(Frame));
+            }
+        }
+    }
+
+    // One material instance for the whole crowd; members only differ in sprite and transform
+    PaletteMaterialInstance = nullptr;
+    if (PaletteTexture && PaletteMaterial)
+    {
+        PaletteMaterialInstance = UMaterialInstanceDynamic::Create(PaletteMaterial, this);
+        PaletteMaterialInstance->SetTextureParameterValue(FSpritePalette::ParameterName, PaletteTexture);
+    }
+    for (int32 MaterialIndex = 0; MaterialIndex < GetNumMaterials(); MaterialIndex++)
+    {
+        SetMaterial(MaterialIndex, PaletteMaterialInstance);
+    }
+
+    UE_LOG(LogCharacterCreation, Log, TEXT("Crowd %s uses %s (%d/%d animations)"), *GetName(),
+        WarriorClass ? *WarriorClass->GetName() : TEXT("no class"),
+        NumAnimationTypes - Algo::Count(Animations, nullptr), NumAnimationTypes);
+}
+
+UPaperSprite* UWarriorCrowdComponent::GetFirstFrame(EAnimationType Type) const
+{
+    const FCrowdClip& Clip = Clips[static_cast<int32>(Type)];
+    return Clip.Frames.Num() > 0 ? Clip.Frames[0] : nullptr;
+}
+
+FTransform UWarriorCrowdComponent::GetMemberTransform(const FCrowdMember& Member)
+{
+    // Same flip as AWarriorCharacter::UpdateSpriteDirection
+    return FTransform(FQuat::Identity, Member.Location, FVector(Member.bFacingRight ? 1.0f : -1.0f, 1.0f, 1.0f));
+}
+
+int32 UWarriorCrowdComponent::AddMember(const FVector& Location, bool bFacingRight)
+{
+    if (WarriorClass && Animations.Num() == 0)
+    {
+        BuildClips();
+    }
+
+    FCrowdMember Member;
+    Member.Location = Location;
+    Member.bFacingRight = bFacingRight;
+
+    const FCrowdClip& Idle = Clips[static_cast<int32>(EAnimationType::Idle)];
+    // A whole number of frames, so every member still changes frame on the same ticks
+    if (bRandomizeStartTime && Idle.FramesPerSecond > 0.0f && Idle.Frames.Num() > 0)
+    {
+        Member.Time = FMath::RandRange(0, Idle.Frames.Num() - 1) / Idle.FramesPerSecond;
+    }
+
+    const int32 Index = AddInstanceWithMaterial(GetMemberTransform(Member), GetFirstFrame(EAnimationType::Idle), PaletteMaterialInstance);
+    Member.bTransformDirty = false;
+    Members.Add(Member);
+    return Index;
+}
+
+void UWarriorCrowdComponent::RemoveMember(int32 MemberIndex)
+{
+    if (Members.IsValidIndex(MemberIndex))
+    {
+        Members.RemoveAt(MemberIndex);
+        RemoveInstance(MemberIndex);
+    }
+}
+
+void UWarriorCrowdComponent::ClearMembers()
+{
+    Members.Reset();
+    ClearInstances();
+}
+
+void UWarriorCrowdComponent::SetMemberLocation(int32 MemberIndex, const FVector& Location, bool bFacingRight)
+{
+    if (Members.IsValidIndex(MemberIndex))
+    {
+        FCrowdMember& Member = Members[MemberIndex];
+        Member.bTransformDirty |= Member.Location != Location || Member.bFacingRight != bFacingRight;
+        Member.Location = Location;
+        Member.bFacingRight = bFacingRight;
+    }
+}
+
+void UWarriorCrowdComponent::PlayMemberAnimation(int32 MemberIndex, EAnimationType Type)
+{
+    if (!Members.IsValidIndex(MemberIndex))
+    {
+        return;
+    }
+
+    // Like the warrior, a looping clip that is already playing keeps its time; attacks restart
+    FCrowdMember& Member = Members[MemberIndex];
+    if (Member.Animation != Type || AWarriorCharacter::IsAttack(Type))
+    {
+        Member.Animation = Type;
+        Member.Time = 0.0f;
+        Member.Frame = INDEX_NONE;
+    }
+}
+
+void UWarriorCrowdComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+    bool bSpritesChanged = false;
+    bool bTransformsChanged = false;
+
+    // Instances added or removed behind our back through the base class API are not animated
+    const int32 NumMembers = FMath::Min(Members.Num(), PerInstanceSpriteData.Num());
+    for (int32 Index = 0; Index < NumMembers; Index++)
+    {
+        FCrowdMember& Member = Members[Index];
+        Member.Time += DeltaTime;
+
+        const FCrowdClip* Clip = &Clips[static_cast<int32>(Member.Animation)];
+        if (Clip->bLooping && Clip->FramesPerSecond > 0.0f && Clip->Frames.Num() > 0)
+        {
+            // Wrap by whole loops so a long-lived member keeps its float precision
+            Member.Time = FMath::Fmod(Member.Time, Clip->Frames.Num() / Clip->FramesPerSecond);
+        }
+
+        int32 Frame = FMath::FloorToInt32(Member.Time * Clip->FramesPerSecond);
+        if (!Clip->bLooping && Frame >= Clip->Frames.Num())
+        {
+            Member.Animation = EAnimationType::Idle;
+            Member.Time = 0.0f;
+            Clip = &Clips[static_cast<int32>(EAnimationType::Idle)];
+            Frame = 0;
+        }
+
+        if (Clip->Frames.Num() > 0)
+        {
+            Frame %= Clip->Frames.Num();
+            if (Frame != Member.Frame)
+            {
+                UPaperSprite* Sprite = Clip->Frames[Frame];
+                if (PerInstanceSpriteData[Index].SourceSprite != Sprite)
+                {
+                    PerInstanceSpriteData[Index].SourceSprite = Sprite;
+                    bSpritesChanged = true;
+                }
+                Member.Frame = Frame;
+            }
+        }
+
+        if (Member.bTransformDirty)
+        {
+            PerInstanceSpriteData[Index].Transform = GetMemberTransform(Member).ToMatrixWithScale();
+            Member.bTransformDirty = false;
+            bTransformsChanged = true;
+        }
+    }
+
+    // The grouped sprite proxy is rebuilt as a whole, so at most once per tick and only when needed.
+    // Members of one clip change frame on the same ticks, so at sprite frame rates most ticks change nothing.
+    if (bTransformsChanged)
+    {
+        UpdateBounds();
+    }
+    if (bSpritesChanged || bTransformsChanged)
+    {
+        MarkRenderStateDirty();
+    }
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PaperGroupedSpriteComponent.h"
+#include "CharacterCreationCommandlet/WarriorAnimationSet.h"
+#include "WarriorCrowdComponent.generated.h"
+
+class AWarriorCharacter;
+class UPaperSprite;
+class UMaterialInstanceDynamic;
+
+/**
+ * Draws many warriors of one class as instances of a single grouped sprite component, without an
+ * actor, capsule, movement or flipbook component per warrior. Members only animate and move where
+ * told to; gameplay stays with full AWarriorCharacters.
+ *
+ * Uses the flipbooks generated for WarriorClass. Every member's frame is advanced in one pass per
+ * tick, and the render proxy is rebuilt only on ticks where some member's sprite or transform changed.
+ */
+UCLASS(ClassGroup = (Paper2D), meta = (BlueprintSpawnableComponent))
+class CHARACTERCREATIONCPP_API UWarriorCrowdComponent : public UPaperGroupedSpriteComponent
+{
+    GENERATED_BODY()
+
+public:
+    UWarriorCrowdComponent();
+
+    virtual void BeginPlay() override;
+    virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+    // Switch to the animations and palette of another warrior class; existing members keep their state
+    UFUNCTION(BlueprintCallable, Category = "Crowd")
+    void SetWarriorClass(TSubclassOf<AWarriorCharacter> NewWarriorClass);
+
+    // Add a warrior at Location (component space) playing Idle; returns its index
+    UFUNCTION(BlueprintCallable, Category = "Crowd")
+    int32 AddMember(const FVector& Location, bool bFacingRight = true);
+
+    // Indices above MemberIndex shift down by one, as with RemoveInstance
+    UFUNCTION(BlueprintCallable, Category = "Crowd")
+    void RemoveMember(int32 MemberIndex);
+
+    UFUNCTION(BlueprintCallable, Category = "Crowd")
+    void ClearMembers();
+
+    UFUNCTION(BlueprintCallable, Category = "Crowd")
+    void SetMemberLocation(int32 MemberIndex, const FVector& Location, bool bFacingRight);
+
+    // Attacks play once and return to Idle
+    UFUNCTION(BlueprintCallable, Category = "Crowd")
+    void PlayMemberAnimation(int32 MemberIndex, EAnimationType Type);
+
+    UFUNCTION(BlueprintCallable, Category = "Crowd")
+    int32 GetNumMembers() const { return Members.Num(); }
+
+protected:
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Crowd")
+    TSubclassOf<AWarriorCharacter> WarriorClass;
+
+    // Members start on a random frame of their clip so a crowd does not animate in lockstep
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Crowd")
+    bool bRandomizeStartTime;
+
+private:
+    // One flipbook expanded to a sprite per frame, so a member's frame is a single index
+    struct FCrowdClip
+    {
+        TArray<UPaperSprite*> Frames;
+        float FramesPerSecond = 0.0f;
+        bool bLooping = true;
+    };
+
+    struct FCrowdMember
+    {
+        FVector Location = FVector::ZeroVector;
+        EAnimationType Animation = EAnimationType::Idle;
+        float Time = 0.0f;
+        int32 Frame = INDEX_NONE;
+        bool bFacingRight = true;
+        bool bTransformDirty = true;
+    };
+
+    void BuildClips();
+    UPaperSprite* GetFirstFrame(EAnimationType Type) const;
+    static FTransform GetMemberTransform(const FCrowdMember& Member);
+
+    // Keeps the class's flipbooks, and so every sprite in Clips, alive
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<UPaperFlipbook>> Animations;
+
+    UPROPERTY(Transient)
+    TObjectPtr<UMaterialInstanceDynamic> PaletteMaterialInstance;
+
+    FCrowdClip Clips[NumAnimationTypes];
+    TArray<FCrowdMember> Members;
+};
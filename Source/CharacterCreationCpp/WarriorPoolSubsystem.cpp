@@ -0,0 +1,96 @@
+#include "WarriorPoolSubsystem.h"
+#include "CharacterCreationCommandlet/WarriorCharacter.h"
+#include "Engine/World.h"
+
+bool UWarriorPoolSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+    // Editor preview worlds never spawn warriors at runtime
+    const UWorld* World = Cast<UWorld>(Outer);
+    return World && (World->WorldType == EWorldType::Game || World->WorldType == EWorldType::PIE);
+}
+
+void UWarriorPoolSubsystem::Deinitialize()
+{
+    UE_LOG(LogCharacterCreation, Log, TEXT("Warrior pool: %d hits, %d misses, %d prewarmed, %d left pooled"),
+        Stats.Hits, Stats.Misses, Stats.Prewarmed, Stats.Available);
+
+    Pools.Reset();
+    Stats.Available = 0;
+
+    Super::Deinitialize();
+}
+
+void UWarriorPoolSubsystem::Prewarm(TSubclassOf<AWarriorCharacter> WarriorClass, int32 Count)
+{
+    if (!WarriorClass)
+    {
+        return;
+    }
+
+    FWarriorPoolEntry& Pool = Pools.FindOrAdd(WarriorClass.Get());
+    Pool.Available.Reserve(Count);
+
+    // Far below the level so the spawn never collides with anything before it is hidden
+    const FTransform ParkingTransform(FVector(0.0f, 0.0f, -100000.0f));
+    while (Pool.Available.Num() < Count)
+    {
+        AWarriorCharacter* Warrior = SpawnWarrior(WarriorClass, ParkingTransform);
+        if (!Warrior)
+        {
+            break;
+        }
+
+        Warrior->DeactivateForPool();
+        Pool.Available.Add(Warrior);
+        Stats.Prewarmed++;
+        Stats.Available++;
+    }
+
+    UE_LOG(LogCharacterCreation, Log, TEXT("Warrior pool: %d %s ready"), Pool.Available.Num(), *WarriorClass->GetName());
+}
+
+AWarriorCharacter* UWarriorPoolSubsystem::Acquire(TSubclassOf<AWarriorCharacter> WarriorClass, const FTransform& SpawnTransform)
+{
+    if (!WarriorClass)
+    {
+        return nullptr;
+    }
+
+    if (FWarriorPoolEntry* Pool = Pools.Find(WarriorClass.Get()))
+    {
+        // Pooled warriors can still be destroyed by level streaming or gameplay code
+        while (Pool->Available.Num() > 0)
+        {
+            AWarriorCharacter* Warrior = Pool->Available.Pop(EAllowShrinking::No);
+            Stats.Available--;
+            if (IsValid(Warrior))
+            {
+                Stats.Hits++;
+                Warrior->ReactivateFromPool(SpawnTransform);
+                return Warrior;
+            }
+        }
+    }
+
+    Stats.Misses++;
+    return SpawnWarrior(WarriorClass, SpawnTransform);
+}
+
+void UWarriorPoolSubsystem::Release(AWarriorCharacter* Warrior)
+{
+    if (!IsValid(Warrior) || Warrior->IsPooled())
+    {
+        return;
+    }
+
+    Warrior->DeactivateForPool();
+    Pools.FindOrAdd(Warrior->GetClass()).Available.Add(Warrior);
+    Stats.Available++;
+}
+
+AWarriorCharacter* UWarriorPoolSubsystem::SpawnWarrior(TSubclassOf<AWarriorCharacter> WarriorClass, const FTransform& SpawnTransform) const
+{
+    FActorSpawnParameters SpawnParameters;
+    SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+    return GetWorld()->SpawnActor<AWarriorCharacter>(WarriorClass, SpawnTransform, SpawnParameters);
+}
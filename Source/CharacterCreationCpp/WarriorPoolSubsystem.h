@@ -0,0 +1,76 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WarriorPoolSubsystem.generated.h"
+
+class AWarriorCharacter;
+
+USTRUCT(BlueprintType)
+struct FWarriorPoolStats
+{
+    GENERATED_BODY()
+
+    /** Acquires served from the pool */
+    UPROPERTY(BlueprintReadOnly, Category = "Pool")
+    int32 Hits = 0;
+
+    /** Acquires that had to spawn a new warrior */
+    UPROPERTY(BlueprintReadOnly, Category = "Pool")
+    int32 Misses = 0;
+
+    /** Warriors spawned ahead of time by Prewarm */
+    UPROPERTY(BlueprintReadOnly, Category = "Pool")
+    int32 Prewarmed = 0;
+
+    /** Warriors currently waiting in the pool, all classes */
+    UPROPERTY(BlueprintReadOnly, Category = "Pool")
+    int32 Available = 0;
+};
+
+USTRUCT()
+struct FWarriorPoolEntry
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    TArray<TObjectPtr<AWarriorCharacter>> Available;
+};
+
+/**
+ * Recycles warriors instead of spawning and destroying them, so high-churn scenes skip the
+ * constructor and component setup after warm-up. Callers Release a warrior where they would
+ * Destroy it.
+ */
+UCLASS()
+class CHARACTERCREATIONCPP_API UWarriorPoolSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+    virtual void Deinitialize() override;
+
+    /** Spawn warriors of Class until Count of them wait in the pool */
+    UFUNCTION(BlueprintCallable, Category = "Pool")
+    void Prewarm(TSubclassOf<AWarriorCharacter> WarriorClass, int32 Count);
+
+    /** A pooled warrior of Class placed at SpawnTransform, or a newly spawned one if the pool is empty */
+    UFUNCTION(BlueprintCallable, Category = "Pool")
+    AWarriorCharacter* Acquire(TSubclassOf<AWarriorCharacter> WarriorClass, const FTransform& SpawnTransform);
+
+    /** Return a warrior to its class's pool */
+    UFUNCTION(BlueprintCallable, Category = "Pool")
+    void Release(AWarriorCharacter* Warrior);
+
+    UFUNCTION(BlueprintCallable, Category = "Pool")
+    FWarriorPoolStats GetStats() const { return Stats; }
+
+private:
+    AWarriorCharacter* SpawnWarrior(TSubclassOf<AWarriorCharacter> WarriorClass, const FTransform& SpawnTransform) const;
+
+    UPROPERTY()
+    TMap<TObjectPtr<UClass>, FWarriorPoolEntry> Pools;
+
+    FWarriorPoolStats Stats;
+};
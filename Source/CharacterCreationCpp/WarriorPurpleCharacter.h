@@ -12,7 +12,4 @@ class CHARACTERCREATIONCPP_API AWarriorPurpleCharacter : public AWarriorCharacte
 
 public:
 	AWarriorPurpleCharacter();
-
-protected:
-	virtual void LoadAnimations() override;
 };
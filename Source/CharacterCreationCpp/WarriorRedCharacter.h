@@ -12,7 +12,4 @@ class CHARACTERCREATIONCPP_API AWarriorRedCharacter : public AWarriorCharacter
 
 public:
 	AWarriorRedCharacter();
-
-protected:
-	virtual void LoadAnimations() override;
 };